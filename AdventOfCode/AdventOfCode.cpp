@@ -17,6 +17,7 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 #include "PacketDecoder.hpp"
 #include "ProbeLauncher.hpp"
 #include "SnailfishNumbers.hpp"
+#include "EmbeddedInputs.hpp"
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
@@ -38,47 +39,46 @@ public:
 		{
 			Logger::WriteMessage("Day 1:\n");
 
-			using Iter_t = std::istream_iterator<uint32_t>;
+#if defined(AOC_EMBEDDED_INPUTS)
 			{
-				// Part 1
-				std::ifstream data_file(DATA_DIR / "Day1_input.txt");
-				Assert::IsTrue(data_file.is_open());
-
-				const auto depth_score_1 = sub.boat_systems().depth_score<1>(Iter_t{ data_file }, Iter_t{});
+				// The depths were parsed and scored when this was compiled
+				constexpr auto depth_score_1 = BoatSystems{}.depth_score<1>(embedded::day1_depths.begin(), embedded::day1_depths.end());
+				constexpr auto depth_score_3 = BoatSystems{}.depth_score<3>(embedded::day1_depths.begin(), embedded::day1_depths.end());
 				Logger::WriteMessage(std::format("\tCalculated depth score with window-size of 1: {}\n", depth_score_1).c_str());
+				Logger::WriteMessage(std::format("\tCalculated depth score with window-size of 3: {}\n", depth_score_3).c_str());
 			}
-
-			// Part 2
+#else
+			// Both parts from a single read of the file
 			{
 				std::ifstream data_file(DATA_DIR / "Day1_input.txt");
 				Assert::IsTrue(data_file.is_open());
 
-				const auto depth_score_3 = sub.boat_systems().depth_score<3>(Iter_t{ data_file }, Iter_t{});
+				using Iter_t = std::istream_iterator<uint32_t>;
+				const auto [depth_score_1, depth_score_3] = sub.boat_systems().depth_scores<1, 3>(Iter_t{ data_file }, Iter_t{});
+				Logger::WriteMessage(std::format("\tCalculated depth score with window-size of 1: {}\n", depth_score_1).c_str());
 				Logger::WriteMessage(std::format("\tCalculated depth score with window-size of 3: {}\n", depth_score_3).c_str());
 			}
+#endif
 		}
 
 		// Day 2
 		{
 			Logger::WriteMessage("Day 2:\n");
 
-			using Iter_t = std::istream_iterator<aoc::Direction>;
+			std::ifstream data_file(DATA_DIR / "Day2_input.txt");
+			Assert::IsTrue(data_file.is_open());
+
+			const auto course = aoc::CourseCommands{ data_file };
 
 			// Part 1
 			{
-				std::ifstream data_file(DATA_DIR / "Day2_input.txt");
-				Assert::IsTrue(data_file.is_open());
-
-				const auto net_direction = sub.boat_systems().net_direction(Iter_t{ data_file }, Iter_t{});
+				const auto net_direction = sub.boat_systems().net_direction(course);
 				Logger::WriteMessage(std::format("\tNet direction: ({}, {})\n", net_direction.x, net_direction.y).c_str());
 			}
 
 			// Part 2
 			{
-				std::ifstream data_file(DATA_DIR / "Day2_input.txt");
-				Assert::IsTrue(data_file.is_open());
-
-				const auto net_aiming = sub.boat_systems().net_aiming(Iter_t{ data_file }, Iter_t{});
+				const auto net_aiming = sub.boat_systems().net_aiming(course);
 				Logger::WriteMessage(std::format("\tNet aiming: ({}, {})\n", net_aiming.x, net_aiming.y).c_str());
 			}
 		}
@@ -87,14 +87,38 @@ public:
 		{
 			Logger::WriteMessage("Day 3:\n");
 
+#if defined(AOC_EMBEDDED_INPUTS)
+			// The entries were parsed when this was compiled
+			// Part 1
+			{
+				auto stats = aoc::DiagnosticStats{ embedded::day3_entry_width };
+				for (const auto word : embedded::day3_entries) {
+					stats.add(aoc::DiagnosticEntry(word, embedded::day3_entry_width));
+				}
+
+				const auto power_consumption = aoc::Submarine().boat_systems().power_consumption(stats);
+
+				Logger::WriteMessage(std::format("\tPower: {}\n", power_consumption).c_str());
+			}
+
+			// Part 2
+			{
+				auto log = aoc::DiagnosticLog{};
+				log.load(embedded::day3_entries, embedded::day3_entry_width);
+
+				Logger::WriteMessage(std::format("\tLife support rating: {}\n",
+					aoc::Submarine().boat_systems().life_support_rating(log)).c_str());
+			}
+#else
 			// Part 1
 			{
 				std::ifstream data_file(DATA_DIR / "Day3_input.txt");
 				Assert::IsTrue(data_file.is_open());
 
-				auto log = aoc::DiagnosticLog{ data_file };
+				auto stats = aoc::DiagnosticStats{};
+				stats.add(data_file);
 
-				const auto power_consumption = aoc::Submarine().boat_systems().power_consumption(log);
+				const auto power_consumption = aoc::Submarine().boat_systems().power_consumption(stats);
 
 				Logger::WriteMessage(std::format("\tPower: {}\n", power_consumption).c_str());
 			}
@@ -109,6 +133,7 @@ public:
 				Logger::WriteMessage(std::format("\tLife support rating: {}\n",
 					aoc::Submarine().boat_systems().life_support_rating(log)).c_str());
 			}
+#endif
 		}
 
 		// Day 4
@@ -175,12 +200,21 @@ public:
 		{
 			Logger::WriteMessage("Day 6:\n");
 
-			// Part 1
-			{
+#if defined(AOC_EMBEDDED_INPUTS)
+			// The timers were parsed when this was compiled
+			auto load_shoal = []() { return aoc::LanternfishShoal{}.load(embedded::day6_list); };
+#else
+			auto load_shoal = []() {
 				std::ifstream data_file(DATA_DIR / "Day6_input.txt");
 				Assert::IsTrue(data_file.is_open());
 
-				auto shoal = aoc::LanternfishShoal{}.load(data_file);
+				return aoc::LanternfishShoal{}.load(data_file);
+			};
+#endif
+
+			// Part 1
+			{
+				auto shoal = load_shoal();
 
 				const auto number_of_fish = aoc::LanternfishShoalModel{ shoal }.run_for(std::chrono::days(80)).shoal_size();
 
@@ -189,10 +223,7 @@ public:
 
 			// Part 2
 			{
-				std::ifstream data_file(DATA_DIR / "Day6_input.txt");
-				Assert::IsTrue(data_file.is_open());
-
-				auto shoal = aoc::LanternfishShoal{}.load(data_file);
+				auto shoal = load_shoal();
 
 				const auto number_of_fish = aoc::LanternfishShoalModel{ shoal }.run_for(std::chrono::days(256)).shoal_size();
 
@@ -204,23 +235,28 @@ public:
 		{
 			Logger::WriteMessage("Day 7:\n");
 
-			// Part 1
-			{
+#if defined(AOC_EMBEDDED_INPUTS)
+			// The positions were parsed when this was compiled
+			auto load_crabs = []() { return aoc::CrabSorter{}.load(embedded::day7_list); };
+#else
+			auto load_crabs = []() {
 				std::ifstream data_file(DATA_DIR / "Day7_input.txt");
 				Assert::IsTrue(data_file.is_open());
 
-				const auto [best_position, cost] = aoc::CrabSorter{}.load(data_file).best_position_and_cost([](uint32_t distance) { return distance; });
+				return aoc::CrabSorter{}.load(data_file);
+			};
+#endif
+
+			// Part 1
+			{
+				const auto [best_position, cost] = load_crabs().best_position_and_cost([](uint32_t distance) { return distance; });
 
 				Logger::WriteMessage(std::format("\tBest position: {}, cost: {}\n", best_position, cost).c_str());
 			}
 
 			// Part 2
 			{
-				std::ifstream data_file(DATA_DIR / "Day7_input.txt");
-				Assert::IsTrue(data_file.is_open());
-
-				const auto [best_position, cost] = aoc::CrabSorter{}
-					.load(data_file)
+				const auto [best_position, cost] = load_crabs()
 					.best_position_and_cost([](uint32_t distance) {
 					return (distance * (1 + distance)) / 2;
 						});
@@ -270,7 +306,12 @@ public:
 
 			// Part 2
 			{
-				// Life''s too short! Come back to this one at some point...
+				std::ifstream data_file(DATA_DIR / "Day9_input.txt");
+				Assert::IsTrue(data_file.is_open());
+
+				const auto product = aoc::Submarine().boat_systems().largest_basins_product(data_file);
+
+				Logger::WriteMessage(std::format("\tProduct of the three largest basins: {}\n", product).c_str());
 			}
 		}
 
@@ -520,7 +561,7 @@ public:
 
 		auto depth_score = aoc::Submarine().boat_systems().depth_score<1>(std::istream_iterator<uint32_t>(data_file), std::istream_iterator<uint32_t>());
 
-		Assert::AreEqual(uint32_t{ 1502 }, depth_score);
+		Assert::AreEqual(uint64_t{ 1502 }, depth_score);
 	}
 };
 
@@ -533,7 +574,7 @@ public:
 
 		auto depth_score = aoc::Submarine().boat_systems().depth_score<3>(measurements.begin(), measurements.end());
 
-		Assert::AreEqual(uint32_t{ 5 }, depth_score);
+		Assert::AreEqual(uint64_t{ 5 }, depth_score);
 	}
 
 	TEST_METHOD(RollingWindow3FromFile)
@@ -543,7 +584,7 @@ public:
 
 		auto depth_score = aoc::Submarine().boat_systems().depth_score<3>(std::istream_iterator<uint32_t>(data_file), std::istream_iterator<uint32_t>());
 
-		Assert::AreEqual(uint32_t{ 1538 }, depth_score);
+		Assert::AreEqual(uint64_t{ 1538 }, depth_score);
 	}
 };
 }
@@ -917,6 +958,16 @@ public:
 
 		Assert::AreEqual(size_t{ 545 }, risk);
 	}
+
+	TEST_METHOD(FindLargestBasins)
+	{
+		std::ifstream data_file(DATA_DIR / "Day9_input.txt");
+		Assert::IsTrue(data_file.is_open());
+
+		const auto product = aoc::Submarine().boat_systems().largest_basins_product(data_file);
+
+		Assert::AreEqual(size_t{ 950600 }, product);
+	}
 };
 }
 
@@ -0,0 +1,104 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AdventOfCode.hpp"
+#include "Executor.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Runs the Submarine's analyses on a shared ThreadPool. Every call takes ownership of its input text, so the caller doesn't
+// have to keep a stream alive, and returns a future straight away. A cancelled token stops any analysis that hasn't started
+// yet; its future then throws CancelledException.
+class AsyncSubmarine
+{
+public:
+
+	enum class BingoStrategy
+	{
+		play_to_win,
+		play_to_lose
+	};
+
+	AsyncSubmarine()
+		: _executor{ ThreadPool::shared() }
+	{}
+
+	explicit AsyncSubmarine(std::shared_ptr<ThreadPool> executor)
+		: _executor{ std::move(executor) }
+	{
+		if (!_executor) {
+			throw InvalidArgException("AsyncSubmarine needs an executor");
+		}
+	}
+
+	const Submarine& submarine() const { return _submarine; }
+	ThreadPool& executor() const { return *_executor; }
+
+	template<size_t FORMATIONS>
+	std::future<uint32_t> detect_vents(std::string data, CancellationToken token = {}) const
+	{
+		return _submit(std::move(data), std::move(token), [](const Submarine& sub, std::istream& is) {
+			return sub.boat_systems().detect_vents<FORMATIONS>(is);
+			});
+	}
+
+	std::future<size_t> lava_tube_smoke_risk(std::string data, CancellationToken token = {}) const
+	{
+		return _submit(std::move(data), std::move(token), [](const Submarine& sub, std::istream& is) {
+			return sub.boat_systems().lava_tube_smoke_risk(is);
+			});
+	}
+
+	std::future<uint32_t> power_consumption(std::string data, CancellationToken token = {}) const
+	{
+		return _submit(std::move(data), std::move(token), [](const Submarine& sub, std::istream& is) {
+			auto stats = DiagnosticStats{};
+			stats.add(is);
+
+			return sub.boat_systems().power_consumption(stats);
+			});
+	}
+
+	std::future<uint32_t> life_support_rating(std::string data, CancellationToken token = {}) const
+	{
+		return _submit(std::move(data), std::move(token), [](const Submarine& sub, std::istream& is) {
+			return sub.boat_systems().life_support_rating(DiagnosticLog{ is });
+			});
+	}
+
+	std::future<std::optional<uint32_t>> bingo_score(std::string data, BingoStrategy strategy, CancellationToken token = {}) const
+	{
+		return _submit(std::move(data), std::move(token), [strategy](const Submarine& sub, std::istream& is) {
+			auto game = sub.entertainment().bingo_game();
+			game.load(is);
+
+			return BingoStrategy::play_to_win == strategy ? game.play_to_win().score() : game.play_to_lose().score();
+			});
+	}
+
+private:
+
+	template<typename Fn_T>
+	auto _submit(std::string data, CancellationToken token, Fn_T fn) const -> std::future<std::invoke_result_t<Fn_T, const Submarine&, std::istream&>>
+	{
+		return _executor->submit([sub = _submarine, data = std::move(data), fn = std::move(fn)]() mutable {
+			auto is = std::istringstream{ std::move(data) };
+			return fn(sub, is);
+			}, std::move(token));
+	}
+
+	Submarine _submarine;
+	std::shared_ptr<ThreadPool> _executor;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
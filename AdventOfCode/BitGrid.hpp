@@ -0,0 +1,383 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <bit>
+#include <span>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+class BitGrid
+{
+public:
+	using Word_t = uint64_t;
+	using Size_t = size_t;
+	using Row_t = std::span<Word_t>;
+	using ConstRow_t = std::span<const Word_t>;
+
+	static constexpr Size_t bits_per_word = std::numeric_limits<Word_t>::digits;
+
+	enum Neighbourhood
+	{
+		orthogonal = 0b01,
+		diagonal   = 0b10,
+	};
+
+	BitGrid()
+		: _rows{ 0 }
+		, _cols{ 0 }
+		, _words_per_row{ 0 }
+	{}
+
+	BitGrid(Size_t rows, Size_t cols)
+		: _rows{ rows }
+		, _cols{ cols }
+		, _words_per_row{ _word_count(cols) }
+		, _words(rows * _word_count(cols), Word_t{ 0 })
+	{}
+
+	BitGrid(const BitGrid&) = default;
+	BitGrid& operator=(const BitGrid&) = default;
+
+	BitGrid(BitGrid&&) = default;
+	BitGrid& operator=(BitGrid&&) = default;
+
+	bool operator==(const BitGrid& other) const
+	{
+		return _rows == other._rows && _cols == other._cols && _words == other._words;
+	}
+
+	bool operator!=(const BitGrid& other) const
+	{
+		return !(*this == other);
+	}
+
+	template<typename Value_T>
+	static BitGrid from_matrix(const arma::Mat<Value_T>& mat)
+	{
+		auto out = BitGrid(mat.n_rows, mat.n_cols);
+
+		for (arma::uword c = 0; c < mat.n_cols; ++c) {
+			for (arma::uword r = 0; r < mat.n_rows; ++r) {
+				if (mat.at(r, c) != Value_T{ 0 }) {
+					out.set(r, c);
+				}
+			}
+		}
+
+		return out;
+	}
+
+	template<typename Value_T>
+	arma::Mat<Value_T> as_matrix() const
+	{
+		auto out = arma::Mat<Value_T>(_rows, _cols);
+		out.fill(Value_T{ 0 });
+
+		for (Size_t r = 0; r < _rows; ++r) {
+			for (Size_t c = 0; c < _cols; ++c) {
+				if (test(r, c)) {
+					out.at(r, c) = Value_T{ 1 };
+				}
+			}
+		}
+
+		return out;
+	}
+
+	Size_t rows() const { return _rows; }
+	Size_t cols() const { return _cols; }
+	Size_t words_per_row() const { return _words_per_row; }
+
+	bool test(Size_t row, Size_t col) const
+	{
+		return (_words[_word_index(row, col)] >> (col % bits_per_word)) & Word_t{ 1 };
+	}
+
+	bool at(Size_t row, Size_t col) const
+	{
+		_check_bounds(row, col);
+		return test(row, col);
+	}
+
+	BitGrid& set(Size_t row, Size_t col, bool value = true)
+	{
+		const auto mask = _bit_mask(col);
+		auto& word = _words[_word_index(row, col)];
+
+		word = value ? (word | mask) : (word & ~mask);
+
+		return *this;
+	}
+
+	BitGrid& reset(Size_t row, Size_t col)
+	{
+		return set(row, col, false);
+	}
+
+	BitGrid& flip(Size_t row, Size_t col)
+	{
+		_words[_word_index(row, col)] ^= _bit_mask(col);
+		return *this;
+	}
+
+	BitGrid& clear()
+	{
+		std::fill(_words.begin(), _words.end(), Word_t{ 0 });
+		return *this;
+	}
+
+	BitGrid& invert()
+	{
+		std::transform(_words.begin(), _words.end(), _words.begin(), [](auto w) { return ~w; });
+		_clear_padding();
+
+		return *this;
+	}
+
+	Row_t row(Size_t r) { return { _row_begin(r), _words_per_row }; }
+	ConstRow_t row(Size_t r) const { return { _row_begin(r), _words_per_row }; }
+
+	BitGrid& or_rows(Size_t target, Size_t source) { return _combine_rows(target, source, std::bit_or<Word_t>{}); }
+	BitGrid& and_rows(Size_t target, Size_t source) { return _combine_rows(target, source, std::bit_and<Word_t>{}); }
+	BitGrid& xor_rows(Size_t target, Size_t source) { return _combine_rows(target, source, std::bit_xor<Word_t>{}); }
+
+	BitGrid& operator|=(const BitGrid& other) { return _combine(other, std::bit_or<Word_t>{}); }
+	BitGrid& operator&=(const BitGrid& other) { return _combine(other, std::bit_and<Word_t>{}); }
+	BitGrid& operator^=(const BitGrid& other) { return _combine(other, std::bit_xor<Word_t>{}); }
+
+	friend BitGrid operator|(BitGrid g1, const BitGrid& g2) { return g1 |= g2; }
+	friend BitGrid operator&(BitGrid g1, const BitGrid& g2) { return g1 &= g2; }
+	friend BitGrid operator^(BitGrid g1, const BitGrid& g2) { return g1 ^= g2; }
+
+	Size_t count() const
+	{
+		return std::accumulate(_words.begin(), _words.end(), Size_t{ 0 }, [](auto curr, auto w) {
+			return curr + std::popcount(w);
+			});
+	}
+
+	Size_t count_row(Size_t r) const
+	{
+		const auto words = row(r);
+		return std::accumulate(words.begin(), words.end(), Size_t{ 0 }, [](auto curr, auto w) {
+			return curr + std::popcount(w);
+			});
+	}
+
+	bool any() const
+	{
+		return std::any_of(_words.begin(), _words.end(), [](auto w) { return w != 0; });
+	}
+
+	bool none() const { return !any(); }
+
+	// Reverses the order of the rows, i.e. reflects the grid top-to-bottom.
+	BitGrid& mirror_rows()
+	{
+		for (Size_t top = 0, bottom = _rows; top + 1 < bottom; ++top, --bottom) {
+			std::swap_ranges(_row_begin(top), _row_begin(top) + _words_per_row, _row_begin(bottom - 1));
+		}
+
+		return *this;
+	}
+
+	// Reverses the order of the columns, i.e. reflects the grid left-to-right.
+	BitGrid& mirror_cols()
+	{
+		const auto padding = _words_per_row * bits_per_word - _cols;
+
+		for (Size_t r = 0; r < _rows; ++r) {
+			auto words = row(r);
+			std::reverse(words.begin(), words.end());
+			std::transform(words.begin(), words.end(), words.begin(), _reverse_bits);
+
+			_shift_words_down(words, padding);
+		}
+
+		return *this;
+	}
+
+	// Moves every cell by (row_offset, col_offset). Cells that move off the grid are discarded and vacated cells are cleared.
+	BitGrid shifted(std::ptrdiff_t row_offset, std::ptrdiff_t col_offset) const
+	{
+		auto out = BitGrid(_rows, _cols);
+
+		for (Size_t r = 0; r < _rows; ++r) {
+			const auto source_row = static_cast<std::ptrdiff_t>(r) - row_offset;
+			if (source_row < 0 || source_row >= static_cast<std::ptrdiff_t>(_rows)) {
+				continue;
+			}
+
+			auto target = out.row(r);
+			const auto source = row(static_cast<Size_t>(source_row));
+			std::copy(source.begin(), source.end(), target.begin());
+
+			if (col_offset > 0) {
+				_shift_words_up(target, static_cast<Size_t>(col_offset));
+			}
+			else if (col_offset < 0) {
+				_shift_words_down(target, static_cast<Size_t>(-col_offset));
+			}
+		}
+
+		out._clear_padding();
+
+		return out;
+	}
+
+	// Marks every cell that has at least one set cell in the requested neighbourhood. The cell itself is not considered.
+	template<int NEIGHBOURHOOD>
+	BitGrid neighbour_mask() const
+	{
+		auto out = BitGrid(_rows, _cols);
+
+		if constexpr ((NEIGHBOURHOOD & orthogonal) != 0) {
+			out |= shifted(-1, 0);
+			out |= shifted(1, 0);
+			out |= shifted(0, -1);
+			out |= shifted(0, 1);
+		}
+
+		if constexpr ((NEIGHBOURHOOD & diagonal) != 0) {
+			out |= shifted(-1, -1);
+			out |= shifted(-1, 1);
+			out |= shifted(1, -1);
+			out |= shifted(1, 1);
+		}
+
+		return out;
+	}
+
+private:
+
+	static constexpr Size_t _word_count(Size_t cols)
+	{
+		return (cols + bits_per_word - 1) / bits_per_word;
+	}
+
+	static constexpr Word_t _bit_mask(Size_t col)
+	{
+		return Word_t{ 1 } << (col % bits_per_word);
+	}
+
+	static Word_t _reverse_bits(Word_t w)
+	{
+		w = ((w >> 1) & 0x5555555555555555ull) | ((w & 0x5555555555555555ull) << 1);
+		w = ((w >> 2) & 0x3333333333333333ull) | ((w & 0x3333333333333333ull) << 2);
+		w = ((w >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((w & 0x0F0F0F0F0F0F0F0Full) << 4);
+		w = ((w >> 8) & 0x00FF00FF00FF00FFull) | ((w & 0x00FF00FF00FF00FFull) << 8);
+		w = ((w >> 16) & 0x0000FFFF0000FFFFull) | ((w & 0x0000FFFF0000FFFFull) << 16);
+
+		return (w >> 32) | (w << 32);
+	}
+
+	// Moves the bits of a multi-word row towards higher column indices.
+	static void _shift_words_up(Row_t words, Size_t count)
+	{
+		const auto word_shift = count / bits_per_word;
+		const auto bit_shift = count % bits_per_word;
+
+		for (auto i = words.size(); i-- > 0;) {
+			auto value = Word_t{ 0 };
+			if (i >= word_shift) {
+				value = words[i - word_shift] << bit_shift;
+				if (bit_shift != 0 && i > word_shift) {
+					value |= words[i - word_shift - 1] >> (bits_per_word - bit_shift);
+				}
+			}
+
+			words[i] = value;
+		}
+	}
+
+	// Moves the bits of a multi-word row towards lower column indices.
+	static void _shift_words_down(Row_t words, Size_t count)
+	{
+		const auto word_shift = count / bits_per_word;
+		const auto bit_shift = count % bits_per_word;
+
+		for (Size_t i = 0; i < words.size(); ++i) {
+			auto value = Word_t{ 0 };
+			if (i + word_shift < words.size()) {
+				value = words[i + word_shift] >> bit_shift;
+				if (bit_shift != 0 && i + word_shift + 1 < words.size()) {
+					value |= words[i + word_shift + 1] << (bits_per_word - bit_shift);
+				}
+			}
+
+			words[i] = value;
+		}
+	}
+
+	Size_t _word_index(Size_t row, Size_t col) const
+	{
+		return row * _words_per_row + col / bits_per_word;
+	}
+
+	Word_t* _row_begin(Size_t r) { return _words.data() + r * _words_per_row; }
+	const Word_t* _row_begin(Size_t r) const { return _words.data() + r * _words_per_row; }
+
+	void _check_bounds(Size_t row, Size_t col) const
+	{
+		if (row >= _rows || col >= _cols) {
+			throw OutOfRangeException(std::format("BitGrid position ({}, {}) is outside {}x{} grid", row, col, _rows, _cols));
+		}
+	}
+
+	void _check_same_shape(const BitGrid& other) const
+	{
+		if (_rows != other._rows || _cols != other._cols) {
+			throw InvalidArgException("BitGrids have different shapes");
+		}
+	}
+
+	void _clear_padding()
+	{
+		const auto used_bits = _cols % bits_per_word;
+		if (used_bits == 0) {
+			return;
+		}
+
+		const auto mask = (Word_t{ 1 } << used_bits) - 1;
+		for (Size_t r = 0; r < _rows; ++r) {
+			_row_begin(r)[_words_per_row - 1] &= mask;
+		}
+	}
+
+	template<typename Op_T>
+	BitGrid& _combine_rows(Size_t target, Size_t source, Op_T op)
+	{
+		const auto source_begin = _row_begin(source);
+		std::transform(_row_begin(target), _row_begin(target) + _words_per_row, source_begin, _row_begin(target), op);
+
+		return *this;
+	}
+
+	template<typename Op_T>
+	BitGrid& _combine(const BitGrid& other, Op_T op)
+	{
+		_check_same_shape(other);
+		std::transform(_words.begin(), _words.end(), other._words.begin(), _words.begin(), op);
+
+		return *this;
+	}
+
+	Size_t _rows;
+	Size_t _cols;
+	Size_t _words_per_row;
+	std::vector<Word_t> _words;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,8 @@
 #include "Common.hpp"
 #include <Maths/Geometry.hpp>
 #include "DiagnosticLog.hpp"
+#include "Executor.hpp"
+#include "Stencil.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -17,12 +19,20 @@ using Direction = Point2D<int>;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// The state of an aimed course. It also serves as the effect of a run of commands on any starting state: starting from
+// (x0, aim0, depth0) the run ends at (x0 + x, aim0 + aim, depth0 + depth + aim0 * x). Composing two runs that way is
+// associative, with Aiming{} as the identity, so long courses can be folded or scanned in parallel chunks.
 struct Aiming
 {
 	int x{};
 	int aim{};
 	int depth{};
 
+	static Aiming from(const Direction& d)
+	{
+		return Aiming{} + d;
+	}
+
 	Direction to_direction() const
 	{
 		return { x, depth };
@@ -37,6 +47,142 @@ struct Aiming
 			this->depth + d.x * new_aim
 		};
 	}
+
+	// This run followed by the other one.
+	Aiming operator+(const Aiming& other) const
+	{
+		return {
+			this->x + other.x,
+			this->aim + other.aim,
+			this->depth + other.depth + this->aim * other.x
+		};
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A course held as two parallel arrays, the forward distance and the depth change of each command, so that summing either
+// is a straight pass over one array. load() tokenizes the text of a course in one pass: the command is known from its
+// first character and the number is read with from_chars, without going through a stream extraction per command.
+class CourseCommands
+{
+public:
+	using Value_t = int;
+	using Size_t = size_t;
+
+	CourseCommands() {}
+
+	explicit CourseCommands(std::string_view text)
+	{
+		load(text);
+	}
+
+	explicit CourseCommands(std::istream& is)
+	{
+		load(is);
+	}
+
+	// Throws a ParseException naming the first line that isn't a valid command, and leaves the course empty.
+	void load(std::string_view text) try
+	{
+		clear();
+
+		auto line_number = Size_t{ 0 };
+		for (auto pos = Size_t{ 0 }; pos < text.size();) {
+			++line_number;
+
+			const auto end = std::min(text.find('\n', pos), text.size());
+			auto line = text.substr(pos, end - pos);
+			pos = end + 1;
+
+			if (!line.empty() && line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+
+			if (!line.empty()) {
+				push_back(_parse_command(line, line_number));
+			}
+		}
+	}
+	catch (const Exception&)
+	{
+		clear();
+
+		throw;
+	}
+
+	void load(std::istream& is) try
+	{
+		load(std::string(std::istreambuf_iterator<char>{ is }, std::istreambuf_iterator<char>{}));
+	}
+	catch (const Exception&)
+	{
+		is.setstate(std::ios::failbit);
+
+		throw;
+	}
+
+	void push_back(const Direction& command)
+	{
+		_x.push_back(command.x);
+		_depth.push_back(command.y);
+	}
+
+	void clear()
+	{
+		_x.clear();
+		_depth.clear();
+	}
+
+	Size_t size() const { return _x.size(); }
+
+	std::span<const Value_t> x() const { return _x; }
+	std::span<const Value_t> depth() const { return _depth; }
+
+	Direction operator[](Size_t idx) const { return { _x[idx], _depth[idx] }; }
+
+private:
+	static Direction _parse_command(std::string_view line, Size_t line_number)
+	{
+		const auto invalid = [line, line_number]() {
+			return ParseException(std::format("Invalid course command on line {}: {}", line_number, line), line_number);
+		};
+
+		auto keyword = std::string_view{};
+		switch (line.front()) {
+		case 'f': keyword = "forward"; break;
+		case 'u': keyword = "up"; break;
+		case 'd': keyword = "down"; break;
+		default:
+			throw invalid();
+		}
+
+		if (!line.starts_with(keyword) || line.size() <= keyword.size() || line[keyword.size()] != ' ') {
+			throw invalid();
+		}
+
+		const auto number_begin = line.find_first_not_of(' ', keyword.size());
+		if (number_begin == std::string_view::npos) {
+			throw invalid();
+		}
+
+		const auto number = line.substr(number_begin);
+
+		auto value = Value_t{};
+		const auto [end, error] = std::from_chars(number.data(), number.data() + number.size(), value);
+		if (error != std::errc{} || end != number.data() + number.size()) {
+			throw invalid();
+		}
+
+		switch (line.front()) {
+		case 'f': return { value, 0 };
+		case 'u': return { 0, -value };
+		default: return { 0, value };
+		}
+	}
+
+	std::vector<Value_t> _x;
+	std::vector<Value_t> _depth;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -44,40 +190,32 @@ struct Aiming
 class LifeSupport
 {
 public:
-	LifeSupport(const DiagnosticLog& log) : _log(log) {}
+	LifeSupport(const DiagnosticLog& log) : _index(log) {}
+
+	// Adds an entry that arrived after the log was loaded; the ratings take it into account from then on.
+	void insert(const DiagnosticLog::Entry_t& entry) { _index.insert(entry); }
 
 	static uint32_t score_entry(const DiagnosticLog::Entry_t& entry, const DiagnosticLog::Entry_t& target)
 	{
 		return static_cast<uint32_t>(std::distance(entry.begin(), std::mismatch(entry.begin(), entry.end(), target.begin()).first));
 	}
 
+	// The bit selector is called with the number of remaining entries that have a 0 and a 1 at the current bit, and returns
+	// whether to keep the ones.
 	template<typename BitSelector_T>
 	uint32_t filter_bits_matching(BitSelector_T bit_selector) const
 	{
-		auto entries = std::vector<DiagnosticLog::Entry_t>(_log.begin(), _log.end());
-
-		auto curr_bit_idx = uint32_t{ 0 };
-		auto end = entries.end();
-		while (std::distance(entries.begin(), end) > 1) {
-			auto bits_to_match = bit_selector(entries.begin(), end);
-			end = std::remove_if(entries.begin(), end, [&bits_to_match, curr_bit_idx](auto e) {
-				return e[curr_bit_idx] != bits_to_match[curr_bit_idx];
-				});
-
-			++curr_bit_idx;
-		}
-
-		return DiagnosticLog::entry_as<uint32_t>(entries.front());
+		return DiagnosticLog::entry_as<uint32_t>(_index.select(bit_selector));
 	}
 
 	uint32_t filter_using_most_frequent_bits() const
 	{
-		return filter_bits_matching(DiagnosticLog::most_frequent_bits<DiagnosticLog::Iterator_t>);
+		return filter_bits_matching([](auto zeros, auto ones) { return ones >= zeros; });
 	}
 
 	uint32_t filter_using_least_frequent_bits() const
 	{
-		return filter_bits_matching(DiagnosticLog::least_frequent_bits<DiagnosticLog::Iterator_t>);
+		return filter_bits_matching([](auto zeros, auto ones) { return ones < zeros; });
 	}
 
 	uint32_t rating() const
@@ -89,14 +227,16 @@ public:
 	}
 
 private:
-	const DiagnosticLog& _log;
+	DiagnosticTrie _index;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
 struct LogProcessor
 {
-	static uint32_t power_consumption(const DiagnosticLog& log)
+	// Works on anything that can report its most frequent bits, i.e. a DiagnosticLog or a running DiagnosticStats.
+	template<typename Log_T>
+	static uint32_t power_consumption(const Log_T& log)
 	{
 		const auto most_frequent_bits = log.get_most_frequent_bits();
 		return DiagnosticLog::entry_as<uint32_t>(most_frequent_bits) * DiagnosticLog::flipped_entry_as<uint32_t>(most_frequent_bits);
@@ -110,6 +250,202 @@ struct LogProcessor
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// The number of vent lines through each point in a rectangle, with a summed-area table of the points on two or more of them
+// so that the overlaps in any region are found in constant time. Regions use Rectangle's convention of the top left corner
+// having the larger y; both corners are included, and the parts outside the field are empty.
+class VentField
+{
+public:
+	using Value_t = uint32_t;
+	using Point_t = Point2D<Value_t>;
+	using Region_t = Rectangle<Value_t>;
+	using Density_t = uint32_t;
+
+	struct HotSpot
+	{
+		Point_t point;
+		Density_t density;
+	};
+
+	VentField() = default;
+
+	VentField(Point_t origin, size_t width, size_t height, std::vector<Density_t> densities)
+		: _origin{ origin }
+		, _width{ width }
+		, _height{ height }
+		, _densities{ std::move(densities) }
+		, _overlap_sums((width + 1) * (height + 1))
+	{
+		if (_densities.size() != _width * _height) {
+			throw InvalidArgException(std::format("Vent field of {}x{} needs {} densities, not {}", _width, _height, _width * _height, _densities.size()));
+		}
+
+		for (size_t y = 0; y < _height; ++y) {
+			auto row_sum = uint32_t{ 0 };
+			for (size_t x = 0; x < _width; ++x) {
+				row_sum += _densities[y * _width + x] > 1 ? 1 : 0;
+				_overlap_sums[(y + 1) * (_width + 1) + x + 1] = _overlap_sums[y * (_width + 1) + x + 1] + row_sum;
+			}
+		}
+	}
+
+	const Point_t& origin() const { return _origin; }
+	size_t width() const { return _width; }
+	size_t height() const { return _height; }
+
+	Density_t density(const Point_t& point) const
+	{
+		if (point.x < _origin.x || point.y < _origin.y || point.x - _origin.x >= _width || point.y - _origin.y >= _height) {
+			return 0;
+		}
+
+		return _densities[_index_of(point.x - _origin.x, point.y - _origin.y)];
+	}
+
+	// The number of points on two or more lines, which is the analyzer's score.
+	size_t overlaps() const { return _overlap_sums.empty() ? 0 : _overlap_sums.back(); }
+
+	size_t overlaps_in(const Region_t& region) const
+	{
+		const auto cells = _clip(region);
+		if (!cells) {
+			return 0;
+		}
+
+		const auto [x_begin, x_end, y_begin, y_end] = *cells;
+		const auto stride = _width + 1;
+
+		return _overlap_sums[y_end * stride + x_end] + _overlap_sums[y_begin * stride + x_begin]
+			- _overlap_sums[y_begin * stride + x_end] - _overlap_sums[y_end * stride + x_begin];
+	}
+
+	// The number of points in the region on more than threshold lines. Only the overlaps, with a threshold of 1, have a
+	// table, so other thresholds visit the region's points.
+	size_t count_above(Density_t threshold, const Region_t& region) const
+	{
+		if (threshold == 1) {
+			return overlaps_in(region);
+		}
+
+		const auto cells = _clip(region);
+		if (!cells) {
+			return 0;
+		}
+
+		const auto [x_begin, x_end, y_begin, y_end] = *cells;
+
+		auto out = size_t{ 0 };
+		for (auto y = y_begin; y != y_end; ++y) {
+			const auto row = _densities.begin() + _index_of(0, y);
+			out += static_cast<size_t>(std::count_if(row + x_begin, row + x_end, [threshold](auto density) { return density > threshold; }));
+		}
+
+		return out;
+	}
+
+	// The k points on the most lines, most first. Points on equally many lines are in order of y, then x.
+	std::vector<HotSpot> hottest(size_t k) const
+	{
+		return _to_hot_spots(_select_hottest(_hottest_in(0, _densities.size(), k), k));
+	}
+
+	// As above, with each of the pool's threads selecting the hottest points of its part of the field.
+	std::vector<HotSpot> hottest(size_t k, ThreadPool& pool) const
+	{
+		const auto chunk_results = for_each_chunk(pool, _densities.size(), min_cells_per_chunk, [this, k](size_t chunk_begin, size_t chunk_end) {
+			return _hottest_in(chunk_begin, chunk_end, k);
+			});
+
+		auto candidates = std::vector<size_t>{};
+		for (const auto& chunk_result : chunk_results) {
+			candidates.insert(candidates.end(), chunk_result.begin(), chunk_result.end());
+		}
+
+		return _to_hot_spots(_select_hottest(std::move(candidates), k));
+	}
+
+private:
+	static constexpr size_t min_cells_per_chunk = size_t{ 1 } << 16;
+
+	struct Cells
+	{
+		size_t x_begin;
+		size_t x_end;
+		size_t y_begin;
+		size_t y_end;
+	};
+
+	size_t _index_of(size_t x, size_t y) const { return y * _width + x; }
+
+	std::optional<Cells> _clip(const Region_t& region) const
+	{
+		const auto x_first = std::max<int64_t>(int64_t{ region.top_left().x } - _origin.x, 0);
+		const auto x_last = std::min<int64_t>(int64_t{ region.bottom_right().x } - _origin.x, static_cast<int64_t>(_width) - 1);
+		const auto y_first = std::max<int64_t>(int64_t{ region.bottom_right().y } - _origin.y, 0);
+		const auto y_last = std::min<int64_t>(int64_t{ region.top_left().y } - _origin.y, static_cast<int64_t>(_height) - 1);
+
+		if (x_first > x_last || y_first > y_last) {
+			return std::nullopt;
+		}
+
+		return Cells{ static_cast<size_t>(x_first), static_cast<size_t>(x_last) + 1, static_cast<size_t>(y_first), static_cast<size_t>(y_last) + 1 };
+	}
+
+	bool _is_hotter(size_t left, size_t right) const
+	{
+		return _densities[left] != _densities[right] ? _densities[left] > _densities[right] : left < right;
+	}
+
+	std::vector<size_t> _select_hottest(std::vector<size_t> candidates, size_t k) const
+	{
+		const auto is_hotter = [this](auto left, auto right) { return _is_hotter(left, right); };
+
+		const auto selected = std::min(k, candidates.size());
+		std::partial_sort(candidates.begin(), candidates.begin() + selected, candidates.end(), is_hotter);
+		candidates.resize(selected);
+
+		return candidates;
+	}
+
+	// The indices of the k hottest points on any line among [begin, end), in no particular order.
+	std::vector<size_t> _hottest_in(size_t begin, size_t end, size_t k) const
+	{
+		auto out = std::vector<size_t>{};
+		for (auto idx = begin; idx != end; ++idx) {
+			if (_densities[idx] != 0) {
+				out.push_back(idx);
+			}
+		}
+
+		if (out.size() > k) {
+			std::nth_element(out.begin(), out.begin() + k, out.end(), [this](auto left, auto right) { return _is_hotter(left, right); });
+			out.resize(k);
+		}
+
+		return out;
+	}
+
+	std::vector<HotSpot> _to_hot_spots(const std::vector<size_t>& indices) const
+	{
+		auto out = std::vector<HotSpot>{};
+		out.reserve(indices.size());
+		for (const auto idx : indices) {
+			const auto point = Point_t{ static_cast<Value_t>(_origin.x + idx % _width), static_cast<Value_t>(_origin.y + idx / _width) };
+			out.push_back({ point, _densities[idx] });
+		}
+
+		return out;
+	}
+
+	Point_t _origin;
+	size_t _width = 0;
+	size_t _height = 0;
+	std::vector<Density_t> _densities;
+	std::vector<uint32_t> _overlap_sums;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 class VentAnalyzer
 {
 	using Line_t = Line2d<uint32_t>;
@@ -122,21 +458,100 @@ public:
 		diagonal   = Line_t::diagonal,
 	};
 
+	// How the number of lines through each point is counted. A dense grid over the lines' bounding box is the fastest, but
+	// when the lines are spread thinly over a large area, counts are kept in hashed tiles that cover only the points the
+	// lines pass through. When the lines are long, the sweep finds the overlaps from the lines' ends without visiting the
+	// points in between, so its cost depends on the number of lines and overlaps rather than on the coordinates. The
+	// automatic choice compares the box's area and the number of points on the lines with the number of lines.
+	enum class DensityBackend
+	{
+		automatic,
+		dense,
+		sparse,
+		sweep
+	};
+
 	VentAnalyzer(std::istream& data_stream)
 		: _data_stream{ data_stream }
 	{}
 
 	template<size_t FORMATIONS>
-	uint32_t score() const
+	uint32_t score(DensityBackend backend = DensityBackend::automatic) const
+	{
+		auto lines = _load_lines(_data_stream);
+		const auto relevant_lines = _filter_for<FORMATIONS>(std::move(lines));
+
+		return _count_overlaps(relevant_lines, backend);
+	}
+
+	// Splits the area into tiles and bins the lines, clipped to each tile they pass through, on the pool. The tiles are then
+	// counted independently on the pool, each in its own small grid.
+	template<size_t FORMATIONS>
+	uint32_t score(ThreadPool& pool) const
 	{
 		auto lines = _load_lines(_data_stream);
-		auto relevant_lines = _filter_for<FORMATIONS>(std::move(lines));
-		auto point_densities = _calculate_point_densities<FORMATIONS>(std::move(relevant_lines));
+		const auto relevant_lines = _filter_for<FORMATIONS>(std::move(lines));
+
+		return _count_tiled(relevant_lines, pool);
+	}
+
+	// Counts the lines through every point of their bounding box once, for answering many queries about the same vents.
+	template<size_t FORMATIONS>
+	VentField field() const
+	{
+		auto lines = _load_lines(_data_stream);
+		const auto relevant_lines = _filter_for<FORMATIONS>(std::move(lines));
+		if (relevant_lines.empty()) {
+			return {};
+		}
+
+		const auto bounds = _bounds_of(relevant_lines);
+		if (bounds.width > max_field_cells / bounds.height) {
+			throw OutOfRangeException(std::format("Vent field of {}x{} is too large", bounds.width, bounds.height));
+		}
 
-		return _calculate_score(std::move(point_densities));
+		return { { bounds.x_min, bounds.y_min }, bounds.width, bounds.height, _rasterize_dense<VentField::Density_t>(relevant_lines, bounds) };
 	}
 
 private:
+	using Count_t = uint8_t;
+
+	static constexpr size_t sparse_tile_size = 16;
+	static constexpr size_t min_dense_cells = size_t{ 1 } << 16;
+	static constexpr size_t max_dense_cells_per_point = 8;
+	static constexpr size_t max_rasterized_points_per_line = 64;
+	static constexpr size_t parallel_tile_size = 256;
+	static constexpr size_t min_lines_per_chunk = 1024;
+	static constexpr size_t max_field_cells = size_t{ 1 } << 28;
+
+	using TileBins_t = std::unordered_map<uint64_t, std::vector<Line_t>>;
+
+	// Parallel lines share an orientation. Each line of an orientation has an index, and each point on it a position.
+	enum class Orientation
+	{
+		horizontal,
+		vertical,
+		rising,
+		falling
+	};
+
+	static constexpr size_t orientation_count = 4;
+
+	// The points at positions first to last on one line of an orientation.
+	struct Span
+	{
+		int64_t line;
+		int64_t first;
+		int64_t last;
+	};
+
+	struct Bounds
+	{
+		Line_t::Value_t x_min;
+		Line_t::Value_t y_min;
+		size_t width;
+		size_t height;
+	};
 
 	static std::vector<Line_t> _load_lines(std::istream& is)
 	{
@@ -180,143 +595,1003 @@ private:
 		return std::move(lines);
 	}
 
-	template<size_t FORMATIONS>
-	static std::map<Point_t, uint32_t> _calculate_point_densities(std::vector<Line_t> lines)
+	static LinePoints<Line_t::Value_t> _points_on(const Line_t& line)
 	{
-		auto out = std::map<Point_t, uint32_t>{};
-
-		for (auto& line : lines) {
-			for (auto& point : rasterize<FORMATIONS>(line)) {
-				out[point]++;
-			}
-		}
-
-		return out;
+		return rasterize_view<Line_t::horizontal | Line_t::vertical | Line_t::diagonal>(line);
 	}
 
-	static uint32_t _calculate_score(std::map<Point_t, uint32_t> point_densities)
+	template<typename Count_T>
+	static void _increment(Count_T& count)
 	{
-		return static_cast<uint32_t>(std::count_if(point_densities.begin(), point_densities.end(), [](const auto& point_and_count) {
-			return point_and_count.second > 1;
-			}));
+		count += count < std::numeric_limits<Count_T>::max() ? 1 : 0;
 	}
 
-	std::istream& _data_stream;
-};
-
-///////////////////////////////////////////////////////////////////////////////
-
-template<typename Value_T, arma::uword KERNEL_SIZE>
-class FloorHeightAnalyser
-{
-public:
+	static Bounds _bounds_of(const std::vector<Line_t>& lines)
+	{
+		auto x_min = std::numeric_limits<Line_t::Value_t>::max();
+		auto y_min = std::numeric_limits<Line_t::Value_t>::max();
+		auto x_max = Line_t::Value_t{ 0 };
+		auto y_max = Line_t::Value_t{ 0 };
+
+		for (const auto& line : lines) {
+			x_min = std::min({ x_min, line.start.x, line.finish.x });
+			y_min = std::min({ y_min, line.start.y, line.finish.y });
+			x_max = std::max({ x_max, line.start.x, line.finish.x });
+			y_max = std::max({ y_max, line.start.y, line.finish.y });
+		}
 
-	using Value_t = Value_T;
-	using Size_t = arma::uword;
+		return { x_min, y_min, size_t{ x_max } - x_min + 1, size_t{ y_max } - y_min + 1 };
+	}
 
-	class Minima
+	static uint32_t _count_overlaps(const std::vector<Line_t>& lines, DensityBackend backend)
 	{
-	public:
-		using Value_t = Value_T;
-		using Size_t = size_t;
-		using Point_t = Point3D<Size_t>;
-
-	private:
-		std::vector<Point_t> _points;
+		if (lines.empty()) {
+			return 0;
+		}
 
-	public:
+		const auto bounds = _bounds_of(lines);
+		const auto point_count = std::accumulate(lines.begin(), lines.end(), size_t{ 0 }, [](auto curr, const auto& line) {
+			return curr + _points_on(line).size();
+			});
 
-		using Iterator_t = decltype(_points.begin());
-		using ConstIterator_t = decltype(_points.cbegin());
+		if (DensityBackend::automatic == backend) {
+			const auto cell_limit = std::max(min_dense_cells, max_dense_cells_per_point * point_count);
+			const auto is_dense = bounds.width <= cell_limit / bounds.height;
 
-		Minima& append(std::vector<Point_t>&& new_points)
-		{
-			_points.insert(_points.end(), new_points.begin(), new_points.end());
+			const auto is_long = point_count > max_rasterized_points_per_line * lines.size();
 
-			return *this;
+			backend = is_dense ? DensityBackend::dense : is_long ? DensityBackend::sweep : DensityBackend::sparse;
 		}
 
-		Minima& append(Minima&& new_minima)
-		{
-			return append(std::forward<std::vector<Point_t>>(new_minima._points));
+		switch (backend) {
+		case DensityBackend::dense:
+			return _count_dense(lines, bounds);
+		case DensityBackend::sparse:
+			return _count_sparse(lines);
+		default:
+			return _count_sweep(lines);
 		}
+	}
 
-		Minima& append(Size_t x, Size_t y, Value_t z)
-		{
-			_points.emplace_back(x, y, z);
+	template<typename Count_T>
+	static std::vector<Count_T> _rasterize_dense(const std::vector<Line_t>& lines, const Bounds& bounds)
+	{
+		auto counts = std::vector<Count_T>(bounds.width * bounds.height);
 
-			return *this;
+		for (const auto& line : lines) {
+			for (const auto point : _points_on(line)) {
+				_increment(counts[(point.y - bounds.y_min) * bounds.width + (point.x - bounds.x_min)]);
+			}
 		}
 
-		ConstIterator_t begin() const { return _points.cbegin(); }
-		Iterator_t begin() { return _points.begin(); }
+		return counts;
+	}
 
-		ConstIterator_t end() const { return _points.cend(); }
-		Iterator_t end() { return _points.end(); }
+	static uint32_t _count_dense(const std::vector<Line_t>& lines, const Bounds& bounds)
+	{
+		const auto counts = _rasterize_dense<Count_t>(lines, bounds);
 
-		Size_t size() const { return _points.size(); }
-	};
+		return static_cast<uint32_t>(std::count_if(counts.begin(), counts.end(), [](auto count) { return count > 1; }));
+	}
 
-	Size_t rows() const { return _height_map.n_rows - 2 * KERNEL_SIZE; }
-	Size_t cols() const { return _height_map.n_cols - 2 * KERNEL_SIZE; }
+	static uint64_t _tile_key(uint64_t x, uint64_t y, uint64_t tile_size)
+	{
+		return ((x / tile_size) << 32) | (y / tile_size);
+	}
 
-	FloorHeightAnalyser& load(std::istream& is)
+	// Adds the parts of a line within each tile it passes through to that tile's bin.
+	static void _bin_by_tile(const Line_t& line, TileBins_t& bins)
 	{
-		const auto digits = std::string(std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{});
-		const auto rows = std::count(digits.begin(), digits.end(), '\n') + 1;
-		const auto cols = std::distance(digits.begin(), std::find(digits.begin(), digits.end(), '\n'));
+		constexpr auto tile_size = static_cast<int64_t>(parallel_tile_size);
 
-		if (rows == 0 || cols == 0) {
-			return *this;
-		}
+		const auto dx = static_cast<int64_t>(line.finish.x) - static_cast<int64_t>(line.start.x);
+		const auto dy = static_cast<int64_t>(line.finish.y) - static_cast<int64_t>(line.start.y);
+		const auto step_x = (dx > 0) - (dx < 0);
+		const auto step_y = (dy > 0) - (dy < 0);
 
-		_height_map.resize(rows + (2 * KERNEL_SIZE), cols + (2 * KERNEL_SIZE));
-		_height_map.fill(10);
+		auto x = static_cast<int64_t>(line.start.x);
+		auto y = static_cast<int64_t>(line.start.y);
+		auto remaining = std::max(std::abs(dx), std::abs(dy));
 
-		auto digit = digits.begin();
-		for (arma::uword r = KERNEL_SIZE; r < _height_map.n_rows - KERNEL_SIZE - 1; ++r) {
-			std::transform(digit, std::next(digit, cols), std::next(_height_map.begin_row(r), KERNEL_SIZE),
-				[](auto d) { return static_cast<uint8_t>(d - '0'); });
-			std::advance(digit, cols + 1);
+		// The number of further steps that stay within the tile, along one axis.
+		const auto steps_within = [tile_size](int64_t position, int64_t step) {
+			const auto tile_begin = position - position % tile_size;
+			return step > 0 ? tile_begin + tile_size - 1 - position : step < 0 ? position - tile_begin : std::numeric_limits<int64_t>::max();
+		};
+
+		while (true) {
+			const auto run = std::min({ remaining, steps_within(x, step_x), steps_within(y, step_y) });
+			const auto finish = Point_t{ static_cast<Line_t::Value_t>(x + run * step_x), static_cast<Line_t::Value_t>(y + run * step_y) };
+
+			bins[_tile_key(x, y, parallel_tile_size)].emplace_back(Point_t{ static_cast<Line_t::Value_t>(x), static_cast<Line_t::Value_t>(y) }, finish);
+
+			if (run == remaining) {
+				break;
+			}
+
+			x += (run + 1) * step_x;
+			y += (run + 1) * step_y;
+			remaining -= run + 1;
+		}
+	}
+
+	static uint32_t _count_tiled(const std::vector<Line_t>& lines, ThreadPool& pool)
+	{
+		if (lines.empty()) {
+			return 0;
+		}
+
+		auto chunk_bins = for_each_chunk(pool, lines.size(), min_lines_per_chunk, [&lines](size_t chunk_begin, size_t chunk_end) {
+			auto bins = TileBins_t{};
+			for (auto idx = chunk_begin; idx != chunk_end; ++idx) {
+				_bin_by_tile(lines[idx], bins);
+			}
+
+			return bins;
+			});
+
+		auto bins = std::move(chunk_bins.front());
+		for (auto chunk = std::next(chunk_bins.begin()); chunk != chunk_bins.end(); ++chunk) {
+			for (auto& [key, segments] : *chunk) {
+				auto& bin = bins[key];
+				bin.insert(bin.end(), segments.begin(), segments.end());
+			}
+		}
+
+		auto tiles = std::vector<std::vector<Line_t>>{};
+		tiles.reserve(bins.size());
+		for (auto& [key, segments] : bins) {
+			tiles.push_back(std::move(segments));
+		}
+
+		const auto tile_scores = for_each_chunk(pool, tiles.size(), 1, [&tiles](size_t chunk_begin, size_t chunk_end) {
+			auto counts = std::vector<Count_t>(parallel_tile_size * parallel_tile_size);
+			auto out = uint32_t{ 0 };
+
+			for (auto idx = chunk_begin; idx != chunk_end; ++idx) {
+				std::fill(counts.begin(), counts.end(), Count_t{ 0 });
+				for (const auto& segment : tiles[idx]) {
+					for (const auto point : _points_on(segment)) {
+						_increment(counts[(point.y % parallel_tile_size) * parallel_tile_size + point.x % parallel_tile_size]);
+					}
+				}
+
+				out += static_cast<uint32_t>(std::count_if(counts.begin(), counts.end(), [](auto count) { return count > 1; }));
+			}
+
+			return out;
+			});
+
+		return std::accumulate(tile_scores.begin(), tile_scores.end(), uint32_t{ 0 });
+	}
+
+	static uint32_t _count_sparse(const std::vector<Line_t>& lines)
+	{
+		using Tile_t = std::array<Count_t, sparse_tile_size * sparse_tile_size>;
+
+		auto tiles = std::unordered_map<uint64_t, Tile_t>{};
+
+		for (const auto& line : lines) {
+			for (const auto point : _points_on(line)) {
+				const auto key = _tile_key(point.x, point.y, sparse_tile_size);
+				_increment(tiles[key][(point.y % sparse_tile_size) * sparse_tile_size + point.x % sparse_tile_size]);
+			}
+		}
+
+		return std::accumulate(tiles.begin(), tiles.end(), uint32_t{ 0 }, [](auto curr, const auto& key_and_tile) {
+			const auto& tile = key_and_tile.second;
+			return curr + static_cast<uint32_t>(std::count_if(tile.begin(), tile.end(), [](auto count) { return count > 1; }));
+			});
+	}
+
+	static constexpr int64_t _line_at(Orientation orientation, int64_t x, int64_t y)
+	{
+		switch (orientation) {
+		case Orientation::horizontal: return y;
+		case Orientation::vertical: return x;
+		case Orientation::rising: return y - x;
+		default: return y + x;
+		}
+	}
+
+	static constexpr int64_t _position_at(Orientation orientation, int64_t x, int64_t y)
+	{
+		return Orientation::vertical == orientation ? y : x;
+	}
+
+	static constexpr std::pair<int64_t, int64_t> _point_at(Orientation orientation, int64_t line, int64_t position)
+	{
+		switch (orientation) {
+		case Orientation::horizontal: return { position, line };
+		case Orientation::vertical: return { line, position };
+		case Orientation::rising: return { position, line + position };
+		default: return { position, line - position };
+		}
+	}
+
+	static Orientation _orientation_of(const Line_t& line)
+	{
+		if (line.start.y == line.finish.y) {
+			return Orientation::horizontal;
+		}
+
+		if (line.start.x == line.finish.x) {
+			return Orientation::vertical;
+		}
+
+		return (line.start.x < line.finish.x) == (line.start.y < line.finish.y) ? Orientation::rising : Orientation::falling;
+	}
+
+	// Merges the spans of one orientation into the spans covering their points, and the spans covering the points that are
+	// on more than one of them.
+	static void _merge_spans(std::vector<Span> spans, std::vector<Span>& covered, std::vector<Span>& overlapping)
+	{
+		std::sort(spans.begin(), spans.end(), [](const auto& left, const auto& right) {
+			return std::tie(left.line, left.first) < std::tie(right.line, right.first);
+			});
+
+		for (const auto& span : spans) {
+			if (covered.empty() || covered.back().line != span.line || covered.back().last + 1 < span.first) {
+				covered.push_back(span);
+				continue;
+			}
+
+			auto& current = covered.back();
+			if (span.first <= current.last) {
+				const auto overlap = Span{ span.line, span.first, std::min(span.last, current.last) };
+				if (!overlapping.empty() && overlapping.back().line == overlap.line && overlap.first <= overlapping.back().last + 1) {
+					overlapping.back().last = std::max(overlapping.back().last, overlap.last);
+				}
+				else {
+					overlapping.push_back(overlap);
+				}
+			}
+
+			current.last = std::max(current.last, span.last);
+		}
+	}
+
+	// Calls fn(x, y) for every point on both a span of one orientation and a span of another. Seen along the lines of the
+	// other orientation, each span of the first covers a range of their indices at a fixed index of its own, and the other
+	// way round, so the crossings are found by sweeping over the second orientation's lines with the first's active ones
+	// kept in order. Spans within an orientation must not overlap.
+	template<typename Fn_T>
+	static void _for_each_crossing(Orientation sweeping, const std::vector<Span>& sweeping_spans, Orientation swept, const std::vector<Span>& swept_spans, Fn_T fn)
+	{
+		// Index of the line of one orientation met at a position along a line of another; linear in the position.
+		const auto line_met = [](Orientation along, int64_t line, int64_t position, Orientation other) {
+			const auto [x, y] = _point_at(along, line, position);
+			return _line_at(other, x, y);
+		};
+
+		// Where the spans of one orientation are, in terms of the lines of the other.
+		const auto ranges_of = [&line_met](const std::vector<Span>& spans, Orientation along, Orientation other) {
+			auto out = std::vector<Span>{};
+			out.reserve(spans.size());
+			for (const auto& span : spans) {
+				const auto from = line_met(along, span.line, span.first, other);
+				const auto to = line_met(along, span.line, span.last, other);
+				out.push_back({ span.line, std::min(from, to), std::max(from, to) });
+			}
+
+			return out;
+		};
+
+		auto active_ranges = ranges_of(sweeping_spans, sweeping, swept);
+		auto queries = ranges_of(swept_spans, swept, sweeping);
+
+		const auto by_first = [](const auto& left, const auto& right) { return left.first < right.first; };
+		const auto by_line = [](const auto& left, const auto& right) { return left.line < right.line; };
+		std::sort(active_ranges.begin(), active_ranges.end(), by_first);
+		std::sort(queries.begin(), queries.end(), by_line);
+
+		auto closing = std::vector<Span>{ active_ranges };
+		std::sort(closing.begin(), closing.end(), [](const auto& left, const auto& right) { return left.last < right.last; });
+
+		const auto slope = line_met(sweeping, 0, 1, swept) - line_met(sweeping, 0, 0, swept);
+
+		auto active = std::multiset<int64_t>{};
+		auto next_open = active_ranges.begin();
+		auto next_close = closing.begin();
+
+		for (const auto& query : queries) {
+			for (; next_open != active_ranges.end() && next_open->first <= query.line; ++next_open) {
+				active.insert(next_open->line);
+			}
+
+			for (; next_close != closing.end() && next_close->last < query.line; ++next_close) {
+				active.erase(active.find(next_close->line));
+			}
+
+			for (auto it = active.lower_bound(query.first); it != active.end() && *it <= query.last; ++it) {
+				const auto offset = query.line - line_met(sweeping, *it, 0, swept);
+				if (offset % slope != 0) {
+					continue;
+				}
+
+				const auto [x, y] = _point_at(sweeping, *it, offset / slope);
+				fn(x, y);
+			}
+		}
+	}
+
+	// Counts the points on more than one line without visiting the points in between. A point is counted if it is on two
+	// overlapping lines of the same orientation, or on lines of two different orientations. The latter can only be where
+	// those lines cross, so only crossings have to be listed, each point at most once per pair of orientations.
+	static uint32_t _count_sweep(const std::vector<Line_t>& lines)
+	{
+		auto spans = std::array<std::vector<Span>, orientation_count>{};
+		for (const auto& line : lines) {
+			const auto orientation = _orientation_of(line);
+			const auto start = _position_at(orientation, line.start.x, line.start.y);
+			const auto finish = _position_at(orientation, line.finish.x, line.finish.y);
+
+			spans[static_cast<size_t>(orientation)].push_back({ _line_at(orientation, line.start.x, line.start.y), std::min(start, finish), std::max(start, finish) });
+		}
+
+		auto covered = std::array<std::vector<Span>, orientation_count>{};
+		auto overlapping = std::array<std::vector<Span>, orientation_count>{};
+		for (size_t i = 0; i < orientation_count; ++i) {
+			_merge_spans(std::move(spans[i]), covered[i], overlapping[i]);
+		}
+
+		const auto key_of = [](int64_t x, int64_t y) { return (static_cast<uint64_t>(x) << 32) | static_cast<uint64_t>(y); };
+
+		auto crossings = std::unordered_set<uint64_t>{};
+		for (size_t i = 0; i < orientation_count; ++i) {
+			for (auto j = i + 1; j < orientation_count; ++j) {
+				_for_each_crossing(static_cast<Orientation>(i), covered[i], static_cast<Orientation>(j), covered[j], [&](auto x, auto y) {
+					crossings.insert(key_of(x, y));
+					});
+			}
+		}
+
+		auto out = crossings.size();
+
+		// Overlaps that are also crossings have been counted already.
+		for (size_t i = 0; i < orientation_count; ++i) {
+			auto crossed_overlaps = std::unordered_set<uint64_t>{};
+			for (size_t j = 0; j < orientation_count; ++j) {
+				if (i != j) {
+					_for_each_crossing(static_cast<Orientation>(i), overlapping[i], static_cast<Orientation>(j), covered[j], [&](auto x, auto y) {
+						crossed_overlaps.insert(key_of(x, y));
+						});
+				}
+			}
+
+			out += std::accumulate(overlapping[i].begin(), overlapping[i].end(), size_t{ 0 }, [](auto curr, const auto& span) {
+				return curr + static_cast<size_t>(span.last - span.first + 1);
+				}) - crossed_overlaps.size();
+		}
+
+		return static_cast<uint32_t>(out);
+	}
+
+	std::istream& _data_stream;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// What makes a cell a minimum, given its height and one of its neighbours'. A cell is a minimum if this holds for all of its
+// neighbours.
+struct StrictMinimum
+{
+	template<typename Value_T>
+	static constexpr bool is_minimum_against(Value_T value, Value_T neighbour) { return value < neighbour; }
+};
+
+struct NonStrictMinimum
+{
+	template<typename Value_T>
+	static constexpr bool is_minimum_against(Value_T value, Value_T neighbour) { return value <= neighbour; }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Grid_T is the storage for the padded height map; anything with n_rows, n_cols, fill() and at(row, col) works, e.g. a
+// TiledGrid for large maps. Stencil_T is the neighbourhood a minimum is compared against, with a radius of KERNEL_SIZE,
+// and Minimum_T decides whether ties count.
+template<typename Value_T, arma::uword KERNEL_SIZE, typename Grid_T = arma::Mat<Value_T>,
+	typename Stencil_T = stencil::FourConnected<KERNEL_SIZE>, typename Minimum_T = StrictMinimum>
+class FloorHeightAnalyser
+{
+	static_assert(Stencil_T::radius == KERNEL_SIZE, "The stencil's radius must match the kernel size");
+
+	using Halo_t = stencil::Halo<Stencil_T>;
+
+public:
+
+	using Value_t = Value_T;
+	using Size_t = arma::uword;
+	using Grid_t = Grid_T;
+
+	class Minima
+	{
+	public:
+		using Value_t = Value_T;
+		using Size_t = size_t;
+		using Point_t = Point3D<Size_t>;
+
+	private:
+		std::vector<Point_t> _points;
+
+	public:
+
+		using Iterator_t = decltype(_points.begin());
+		using ConstIterator_t = decltype(_points.cbegin());
+
+		Minima& append(std::vector<Point_t>&& new_points)
+		{
+			_points.insert(_points.end(), new_points.begin(), new_points.end());
+
+			return *this;
+		}
+
+		Minima& append(Minima&& new_minima)
+		{
+			return append(std::forward<std::vector<Point_t>>(new_minima._points));
+		}
+
+		Minima& append(Size_t x, Size_t y, Value_t z)
+		{
+			_points.emplace_back(x, y, z);
+
+			return *this;
+		}
+
+		ConstIterator_t begin() const { return _points.cbegin(); }
+		Iterator_t begin() { return _points.begin(); }
+
+		ConstIterator_t end() const { return _points.cend(); }
+		Iterator_t end() { return _points.end(); }
+
+		Size_t size() const { return _points.size(); }
+	};
+
+	// The basins of a height map: the regions of cells, connected up, down, left and right, that are bounded by cells of
+	// height 9. Labels use the analyser's padded layout, so they line up with the minima's coordinates; cells of height 9
+	// and the padding have no basin.
+	class Basins
+	{
+	public:
+		using Label_t = uint32_t;
+		using Size_t = size_t;
+
+		static constexpr Label_t no_basin = 0;
+
+		Basins() = default;
+
+		Basins(arma::Mat<Label_t> labels, std::vector<Size_t> sizes)
+			: _labels{ std::move(labels) }
+			, _sizes{ std::move(sizes) }
+		{}
+
+		// Basins are numbered from 1, in order of their first cell in column-major order.
+		Label_t label(Size_t row, Size_t col) const { return _labels.at(row, col); }
+		const arma::Mat<Label_t>& labels() const { return _labels; }
+
+		Size_t count() const { return _sizes.size(); }
+		Size_t size_of(Label_t label) const { return _sizes.at(label - 1); }
+		const std::vector<Size_t>& sizes() const { return _sizes; }
+
+		// The product of the sizes of the n largest basins.
+		Size_t largest_product(Size_t n = 3) const
+		{
+			auto sizes = _sizes;
+			const auto largest = std::min(n, sizes.size());
+			std::partial_sort(sizes.begin(), sizes.begin() + largest, sizes.end(), std::greater<>{});
+
+			return std::accumulate(sizes.begin(), sizes.begin() + largest, Size_t{ 1 }, std::multiplies<>{});
+		}
+
+	private:
+		arma::Mat<Label_t> _labels;
+		std::vector<Size_t> _sizes;
+	};
+
+	Size_t rows() const { return _height_map.n_rows - 2 * KERNEL_SIZE; }
+	Size_t cols() const { return _height_map.n_cols - 2 * KERNEL_SIZE; }
+
+	FloorHeightAnalyser& load(std::istream& is)
+	{
+		const auto digits = std::string(std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{});
+		const auto rows = std::count(digits.begin(), digits.end(), '\n') + 1;
+		const auto cols = std::distance(digits.begin(), std::find(digits.begin(), digits.end(), '\n'));
+
+		if (rows == 0 || cols == 0) {
+			return *this;
+		}
+
+		_height_map = Halo_t::template make_as<Grid_t>(rows, cols, Value_t{ 10 });
+
+		auto digit = digits.begin();
+		for (arma::uword r = KERNEL_SIZE; r < _height_map.n_rows - KERNEL_SIZE; ++r) {
+			for (arma::uword c = KERNEL_SIZE; c < _height_map.n_cols - KERNEL_SIZE; ++c) {
+				_height_map.at(r, c) = static_cast<Value_t>(*digit++ - '0');
+			}
+
+			if (digit != digits.end()) {
+				++digit;
+			}
+		}
+
+		return *this;
+	}
+
+	Minima find_minima() const
+	{
+		if constexpr (has_contiguous_columns) {
+			return _find_minima_in_columns(KERNEL_SIZE, _height_map.n_cols - KERNEL_SIZE);
+		}
+		else {
+			auto out = Minima{};
+
+			Halo_t::for_each_cell(_height_map, [this, &out](auto row, auto col, const auto& neighbours) {
+				const auto ref_value = _height_map.at(row, col);
+				if (!_is_minimum(neighbours, ref_value)) {
+					return;
+				}
+
+				out.append(col, row, ref_value);
+				});
+
+			return out;
+		}
+	}
+
+	// As above, with the columns split into bands that are searched on the pool. The minima are in the same order.
+	Minima find_minima(ThreadPool& pool) const
+	{
+		if constexpr (has_contiguous_columns) {
+			if (_height_map.n_cols <= 2 * KERNEL_SIZE) {
+				return {};
+			}
+
+			auto band_minima = for_each_chunk(pool, cols(), min_columns_per_band, [this](size_t band_begin, size_t band_end) {
+				return _find_minima_in_columns(band_begin + KERNEL_SIZE, band_end + KERNEL_SIZE);
+				});
+
+			auto out = Minima{};
+			for (auto& minima : band_minima) {
+				out.append(std::move(minima));
+			}
+
+			return out;
+		}
+		else {
+			return find_minima();
+		}
+	}
+
+	Basins find_basins() const
+	{
+		return _find_basins([](size_t size, auto fn) {
+			return std::vector<std::invoke_result_t<decltype(fn), size_t, size_t>>{ fn(size_t{ 0 }, size) };
+			});
+	}
+
+	// As above, labelling bands of columns on the pool. The labels are the same as those found on one thread.
+	Basins find_basins(ThreadPool& pool) const
+	{
+		return _find_basins([&pool](size_t size, auto fn) {
+			return for_each_chunk(pool, size, min_columns_per_band, fn);
+			});
+	}
+
+private:
+	using Label_t = typename Basins::Label_t;
+
+	struct Band
+	{
+		Size_t col_begin;
+		Size_t col_end;
+	};
+
+	bool _is_basin(Size_t row, Size_t col) const { return _height_map.at(row, col) < Value_t{ 9 }; }
+
+	// Cells are indexed in column-major order over the padded map, like an arma::Mat's storage.
+	static Label_t _find_root(const std::vector<Label_t>& parents, Label_t idx)
+	{
+		while (parents[idx] != idx) {
+			idx = parents[idx];
+		}
+
+		return idx;
+	}
+
+	// Joins the sets of two cells, keeping the lower index as the root so that each basin's root is its first cell.
+	static void _unite(std::vector<Label_t>& parents, Label_t first, Label_t second)
+	{
+		while (parents[first] != first) {
+			first = parents[first] = parents[parents[first]];
+		}
+
+		while (parents[second] != second) {
+			second = parents[second] = parents[parents[second]];
+		}
+
+		parents[std::max(first, second)] = std::min(first, second);
+	}
+
+	// Labelling runs in passes over bands of columns rather than rows, because an arma::Mat stores each column contiguously
+	// and a band of columns is then one contiguous slice of the map. run_bands(column_count, fn) calls fn(band_begin,
+	// band_end) for each band, in interior column coordinates, and returns the results in band order. It must split the columns the same way
+	// every time. The first pass joins each cell to its basin neighbours above and to the left within the band; the bands
+	// are then joined along their borders. The remaining passes only read other bands' sets, which now make up the
+	// basins, and write their own cells.
+	template<typename RunBands_T>
+	Basins _find_basins(RunBands_T run_bands) const
+	{
+		const auto padded_rows = static_cast<Size_t>(_height_map.n_rows);
+		const auto padded_cols = static_cast<Size_t>(_height_map.n_cols);
+		if (padded_rows <= 2 * KERNEL_SIZE || padded_cols <= 2 * KERNEL_SIZE) {
+			return {};
+		}
+
+		if (padded_rows * padded_cols >= std::numeric_limits<Label_t>::max()) {
+			throw OutOfRangeException(std::format("Height map of {}x{} has too many cells to label", padded_rows, padded_cols));
+		}
+
+		const auto row_begin = KERNEL_SIZE;
+		const auto row_end = padded_rows - KERNEL_SIZE;
+		const auto index_of = [padded_rows](Size_t row, Size_t col) { return static_cast<Label_t>(col * padded_rows + row); };
+
+		auto parents = std::vector<Label_t>(padded_rows * padded_cols);
+		auto labels = arma::Mat<Label_t>(padded_rows, padded_cols);
+		labels.zeros();
+
+		const auto bands = run_bands(cols(), [&](Size_t band_begin, Size_t band_end) {
+			const auto band = Band{ band_begin + KERNEL_SIZE, band_end + KERNEL_SIZE };
+			for (auto c = band.col_begin; c < band.col_end; ++c) {
+				for (auto r = row_begin; r < row_end; ++r) {
+					if (!_is_basin(r, c)) {
+						continue;
+					}
+
+					const auto idx = index_of(r, c);
+					parents[idx] = idx;
+
+					if (_is_basin(r - 1, c)) {
+						_unite(parents, idx, idx - 1);
+					}
+
+					if (c > band.col_begin && _is_basin(r, c - 1)) {
+						_unite(parents, idx, index_of(r, c - 1));
+					}
+				}
+			}
+
+			return band;
+			});
+
+		for (auto band = std::next(bands.begin()); band != bands.end(); ++band) {
+			for (auto r = row_begin; r < row_end; ++r) {
+				if (_is_basin(r, band->col_begin) && _is_basin(r, band->col_begin - 1)) {
+					_unite(parents, index_of(r, band->col_begin), index_of(r, band->col_begin - 1));
+				}
+			}
 		}
 
-		std::transform(digit, std::next(digit, cols), std::next(_height_map.begin_row(rows + KERNEL_SIZE - 1), KERNEL_SIZE),
-			[](auto d) { return static_cast<uint8_t>(d - '0'); });
+		// Each cell gets the index of its basin's first cell, and each band counts the basins that start in it.
+		const auto band_basin_counts = run_bands(cols(), [&](Size_t band_begin, Size_t band_end) {
+			auto out = Label_t{ 0 };
+			for (auto c = band_begin + KERNEL_SIZE; c < band_end + KERNEL_SIZE; ++c) {
+				for (auto r = row_begin; r < row_end; ++r) {
+					if (_is_basin(r, c)) {
+						const auto idx = index_of(r, c);
+						labels[idx] = _find_root(parents, idx);
+						out += labels[idx] == idx ? 1 : 0;
+					}
+				}
+			}
 
-		return *this;
+			return out;
+			});
+
+		auto band_first_labels = std::vector<Label_t>(band_basin_counts.size());
+		std::exclusive_scan(band_basin_counts.begin(), band_basin_counts.end(), band_first_labels.begin(), Label_t{ 1 });
+		const auto basin_count = static_cast<Size_t>(std::accumulate(band_basin_counts.begin(), band_basin_counts.end(), Label_t{ 0 }));
+
+		const auto band_idx_of = [&bands](Size_t band_begin) {
+			const auto band = std::lower_bound(bands.begin(), bands.end(), band_begin + KERNEL_SIZE, [](const auto& band, auto col) {
+				return band.col_begin < col;
+				});
+
+			return static_cast<size_t>(std::distance(bands.begin(), band));
+		};
+
+		// The first cells are numbered in order; the other cells then take their first cell's number.
+		run_bands(cols(), [&](Size_t band_begin, Size_t band_end) {
+			auto next_label = band_first_labels[band_idx_of(band_begin)];
+
+			for (auto c = band_begin + KERNEL_SIZE; c < band_end + KERNEL_SIZE; ++c) {
+				for (auto r = row_begin; r < row_end; ++r) {
+					const auto idx = index_of(r, c);
+					if (_is_basin(r, c) && parents[idx] == idx) {
+						labels[idx] = next_label++;
+					}
+				}
+			}
+
+			return 0;
+			});
+
+		// The basins that start in a band have consecutive labels, so each band counts its own basins straight into their
+		// slots. Cells of basins that started in an earlier band are counted separately and added afterwards; only basins
+		// that cross a band boundary have any.
+		auto sizes = std::vector<Size_t>(basin_count);
+		const auto band_spill_sizes = run_bands(cols(), [&](Size_t band_begin, Size_t band_end) {
+			const auto band_idx = band_idx_of(band_begin);
+			const auto first_label = band_first_labels[band_idx];
+			const auto end_label = first_label + band_basin_counts[band_idx];
+
+			auto out = std::unordered_map<Label_t, Size_t>{};
+			for (auto c = band_begin + KERNEL_SIZE; c < band_end + KERNEL_SIZE; ++c) {
+				for (auto r = row_begin; r < row_end; ++r) {
+					if (!_is_basin(r, c)) {
+						continue;
+					}
+
+					const auto idx = index_of(r, c);
+					if (parents[idx] != idx) {
+						labels[idx] = labels[labels[idx]];
+					}
+
+					const auto label = labels[idx];
+					if (label >= first_label && label < end_label) {
+						++sizes[label - 1];
+					}
+					else {
+						++out[label];
+					}
+				}
+			}
+
+			return out;
+			});
+
+		for (const auto& spill_sizes : band_spill_sizes) {
+			for (const auto& [label, size] : spill_sizes) {
+				sizes[label - 1] += size;
+			}
+		}
+
+		return { std::move(labels), std::move(sizes) };
 	}
 
-	Minima find_minima() const
+	// An arma::Mat keeps each column contiguous, so a column and its neighbouring columns can be compared a block of cells at
+	// a time.
+	static constexpr bool has_contiguous_columns = std::is_same_v<Grid_t, arma::Mat<Value_t>>;
+
+	static constexpr Size_t mask_block_size = 64;
+	static constexpr size_t min_columns_per_band = 64;
+
+	static constexpr auto stencil_size = Stencil_T::offsets.size();
+
+	using NeighbourColumns_t = std::array<const Value_t*, stencil_size>;
+
+	// Whether the cell in the given row is a minimum, with one comparison per stencil offset unrolled at compile time.
+	// neighbour_columns holds the column of each offset's neighbour.
+	template<size_t... IDX>
+	static bool _is_minimum_in_column(const NeighbourColumns_t& neighbour_columns, Value_t value, Size_t row, std::index_sequence<IDX...>)
+	{
+		const auto r = static_cast<std::ptrdiff_t>(row);
+		return (... & Minimum_T::is_minimum_against(value, neighbour_columns[IDX][r + Stencil_T::offsets[IDX].row]));
+	}
+
+	// One bit per cell of [first, first + count) in a column, set where the cell is a minimum. Each cell's comparisons with
+	// its neighbours are and-ed rather than short-circuited, and the flags are only packed into the mask once they're all
+	// known.
+	uint64_t _minima_mask(const Value_t* column, const NeighbourColumns_t& neighbour_columns, Size_t first, Size_t count) const
+	{
+		auto is_minimum = std::array<uint8_t, mask_block_size>{};
+		for (Size_t i = 0; i < count; ++i) {
+			const auto r = first + i;
+			is_minimum[i] = static_cast<uint8_t>(_is_minimum_in_column(neighbour_columns, column[r], r, std::make_index_sequence<stencil_size>{}));
+		}
+
+		auto out = uint64_t{ 0 };
+		for (Size_t i = 0; i < count; ++i) {
+			out |= uint64_t{ is_minimum[i] } << i;
+		}
+
+		return out;
+	}
+
+	Minima _find_minima_in_columns(Size_t col_begin, Size_t col_end) const
 	{
 		auto out = Minima{};
 
-		for (auto col = KERNEL_SIZE; col < _height_map.n_cols - KERNEL_SIZE; ++col) {
-			for (auto row = KERNEL_SIZE; row < _height_map.n_rows - KERNEL_SIZE; ++row) {
-				const auto ref_value = _height_map.at(row, col);
-				if (!_is_minimum(row, col, ref_value)) {
-					continue;
-				}
+		if (_height_map.n_rows <= 2 * KERNEL_SIZE || _height_map.n_cols <= 2 * KERNEL_SIZE) {
+			return out;
+		}
 
-				out.append(col, row, ref_value);
+		const auto row_end = _height_map.n_rows - KERNEL_SIZE;
+		for (auto c = col_begin; c < col_end; ++c) {
+			const auto column = _height_map.colptr(c);
+
+			auto neighbour_columns = NeighbourColumns_t{};
+			std::transform(Stencil_T::offsets.begin(), Stencil_T::offsets.end(), neighbour_columns.begin(), [this, c](const auto& offset) {
+				return _height_map.colptr(static_cast<Size_t>(static_cast<std::ptrdiff_t>(c) + offset.col));
+				});
+
+			for (auto block_begin = KERNEL_SIZE; block_begin < row_end; block_begin += mask_block_size) {
+				const auto count = std::min(mask_block_size, row_end - block_begin);
+				for (auto mask = _minima_mask(column, neighbour_columns, block_begin, count); mask != 0; mask &= mask - 1) {
+					const auto r = block_begin + static_cast<Size_t>(std::countr_zero(mask));
+					out.append(c, r, column[r]);
+				}
 			}
 		}
 
 		return out;
 	}
 
+	template<typename Neighbours_T>
+	bool _is_minimum(const Neighbours_T& neighbours, Value_t ref_value) const
+	{
+		return neighbours.all_of([this, ref_value](auto r, auto c) { return Minimum_T::is_minimum_against(ref_value, _height_map.at(r, c)); });
+	}
+
+	Grid_t _height_map;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Finds the minima of a height map as its rows are read, for maps too large to hold in memory. Only a window of
+// 2 * KERNEL_SIZE + 1 rows is kept, so memory is bounded by the row width. Minima are reported as each row's neighbours
+// below it arrive, in row-major order, using the same padded coordinates as FloorHeightAnalyser.
+template<typename Value_T, size_t KERNEL_SIZE>
+class FloorHeightScanner
+{
+public:
+	using Value_t = Value_T;
+	using Size_t = size_t;
+	using Point_t = Point3D<Size_t>;
+
+	static constexpr Size_t window_rows = 2 * KERNEL_SIZE + 1;
+	static constexpr Size_t block_size = 1 << 16;
+
+	Size_t rows() const { return _rows; }
+	Size_t cols() const { return _cols; }
+
+	// Scans the whole text, e.g. a memory-mapped file, and calls on_minimum(point) for each minimum.
+	template<typename Fn_T>
+	void scan(std::string_view text, Fn_T on_minimum)
+	{
+		_scan_lines(text, on_minimum, true);
+		finish(on_minimum);
+	}
+
+	// Reads the rest of the stream a block at a time. The stream's failbit is set if a row can't be parsed.
+	template<typename Fn_T>
+	void scan(std::istream& is, Fn_T on_minimum) try
+	{
+		auto buffer = std::string{};
+
+		while (is) {
+			const auto unscanned = buffer.size();
+			buffer.resize(unscanned + block_size);
+
+			is.read(buffer.data() + unscanned, block_size);
+			buffer.resize(unscanned + static_cast<Size_t>(is.gcount()));
+
+			buffer.erase(0, _scan_lines(buffer, on_minimum, !is));
+		}
+
+		finish(on_minimum);
+	}
+	catch (const Exception&)
+	{
+		is.setstate(std::ios::failbit);
+
+		throw;
+	}
+
+	// Adds the next row of digits. The minima of the row KERNEL_SIZE above it are then known.
+	template<typename Fn_T>
+	void push_row(std::string_view digits, Fn_T on_minimum)
+	{
+		++_line;
+
+		if (_rows == 0) {
+			_cols = digits.size();
+			_window.assign(window_rows * _padded_cols(), padding_height);
+		}
+		else if (digits.size() != _cols) {
+			throw ParseException(std::format("Row {} has {} heights, but the map is {} wide", _line, digits.size(), _cols), _line);
+		}
+
+		auto row = _row_at(_rows + KERNEL_SIZE) + KERNEL_SIZE;
+		for (const auto digit : digits) {
+			if (digit < '0' || digit > '9') {
+				throw ParseException(std::format("Invalid height in row {}: {}", _line, digits), _line);
+			}
+
+			*row++ = static_cast<Value_t>(digit - '0');
+		}
+
+		// Real row r is padded row r + KERNEL_SIZE, so the row whose last neighbour below has just arrived is padded row r.
+		++_rows;
+		if (_rows > KERNEL_SIZE) {
+			_report_minima(_rows - 1, on_minimum);
+		}
+	}
+
+	// Reports the minima of the last KERNEL_SIZE rows, which have only padding below them.
+	template<typename Fn_T>
+	void finish(Fn_T on_minimum)
+	{
+		if (_rows == 0) {
+			return;
+		}
+
+		for (auto padded_row = _rows + KERNEL_SIZE; padded_row < _rows + 2 * KERNEL_SIZE; ++padded_row) {
+			const auto row = _row_at(padded_row);
+			std::fill(row, row + _padded_cols(), padding_height);
+
+			if (padded_row >= 2 * KERNEL_SIZE) {
+				_report_minima(padded_row - KERNEL_SIZE, on_minimum);
+			}
+		}
+	}
+
 private:
+	static constexpr auto padding_height = Value_t{ 10 };
 
-	bool _is_minimum(Size_t row, Size_t col, Value_t ref_value) const
+	Size_t _padded_cols() const { return _cols + 2 * KERNEL_SIZE; }
+
+	Value_t* _row_at(Size_t padded_row) { return _window.data() + (padded_row % window_rows) * _padded_cols(); }
+
+	// Reports the minima of a row whose neighbours KERNEL_SIZE above and below are in the window.
+	template<typename Fn_T>
+	void _report_minima(Size_t padded_row, Fn_T& on_minimum)
+	{
+		const auto above = _row_at(padded_row - KERNEL_SIZE);
+		const auto centre = _row_at(padded_row);
+		const auto below = _row_at(padded_row + KERNEL_SIZE);
+
+		for (auto c = KERNEL_SIZE; c < KERNEL_SIZE + _cols; ++c) {
+			const auto value = centre[c];
+			if ((value < above[c]) & (value < below[c]) & (value < centre[c - KERNEL_SIZE]) & (value < centre[c + KERNEL_SIZE])) {
+				on_minimum(Point_t{ c, padded_row, value });
+			}
+		}
+	}
+
+	template<typename Fn_T>
+	Size_t _scan_lines(std::string_view text, Fn_T& on_minimum, bool is_last)
 	{
-		const auto above = _height_map.at(row - KERNEL_SIZE, col);
-		const auto below = _height_map.at(row + KERNEL_SIZE, col);
-		const auto left  = _height_map.at(row, col - KERNEL_SIZE);
-		const auto right = _height_map.at(row, col + KERNEL_SIZE);
+		auto pos = Size_t{ 0 };
+		while (pos < text.size()) {
+			auto end = text.find('\n', pos);
+			if (end == std::string_view::npos) {
+				if (!is_last) {
+					break;
+				}
 
-		return (ref_value < above) && (ref_value < below) && (ref_value < left) && ref_value < right;
+				end = text.size();
+			}
+
+			auto line = text.substr(pos, end - pos);
+			if (!line.empty() && line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+
+			pos = std::min(end + 1, text.size());
+
+			if (!line.empty()) {
+				push_row(line, on_minimum);
+			}
+		}
+
+		return pos;
 	}
 
-	arma::Mat<Value_t> _height_map;
+	std::vector<Value_t> _window;
+	Size_t _rows = 0;
+	Size_t _cols = 0;
+	Size_t _line = 0;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -325,29 +1600,117 @@ class BoatSystems
 {
 public:
 	template<size_t WINDOW_SIZE, typename Iter_T>
-	uint32_t depth_score(Iter_T begin, Iter_T end) const
+	constexpr uint64_t depth_score(Iter_T begin, Iter_T end) const
+	{
+		if constexpr (std::contiguous_iterator<Iter_T>) {
+			return depth_score<WINDOW_SIZE>(std::span{ begin, end });
+		}
+		else {
+			auto current_idx = size_t{ 0 };
+
+			auto window = std::array<std::iter_value_t<Iter_T>, WINDOW_SIZE>{};
+			for (auto it = window.begin(); it < window.end(); ++it, ++current_idx) {
+				*it = *begin++;
+			}
+
+			auto prev_score = std::accumulate(window.begin(), window.end(), uint32_t{ 0 });
+
+			return std::accumulate(begin, end, uint64_t{ 0 }, [&window, &prev_score, &current_idx](auto curr, auto next) {
+
+				auto new_score = uint32_t{ prev_score - window[current_idx % window.size()] + next };
+
+				auto out = new_score > prev_score ? ++curr : curr;
+
+				prev_score = new_score;
+				window[current_idx % window.size()] = next;
+				++current_idx;
+
+				return out;
+				});
+		}
+	}
+
+	// Consecutive windows share all but one value, so a window's sum is larger than the previous one exactly when the value
+	// entering it is larger than the one leaving: the score is the number of i with depths[i] > depths[i - WINDOW_SIZE]. Each
+	// block of 64Ki comparisons is counted in 32 bits, which can't overflow, and the block counts are summed in 64 bits.
+	template<size_t WINDOW_SIZE, typename Value_T, size_t EXTENT>
+	constexpr uint64_t depth_score(std::span<Value_T, EXTENT> depths) const
 	{
-		auto current_idx = size_t{ 0 };
+		static_assert(WINDOW_SIZE > 0, "Depth windows need at least one value");
+
+		constexpr auto block_size = size_t{ 1 } << 16;
+
+		const auto* data = depths.data();
+		const auto size = depths.size();
 
-		auto window = std::array<typename Iter_T::value_type, WINDOW_SIZE>{};
-		for (auto it = window.begin(); it < window.end(); ++it, ++current_idx) {
-			*it = *begin++;
+		auto out = uint64_t{ 0 };
+		for (auto block = WINDOW_SIZE; block < size; block += block_size) {
+			const auto block_end = std::min(size, block + block_size);
+
+			auto block_count = uint32_t{ 0 };
+			for (auto i = block; i < block_end; ++i) {
+				block_count += data[i] > data[i - WINDOW_SIZE] ? 1 : 0;
+			}
+
+			out += block_count;
 		}
 
-		auto prev_score = std::accumulate(window.begin(), window.end(), uint32_t{ 0 });
+		return out;
+	}
+
+	// The depth scores for several window sizes from a single read of the data, in the order the sizes are given.
+	template<size_t... WINDOW_SIZES, typename Iter_T>
+	std::array<uint64_t, sizeof...(WINDOW_SIZES)> depth_scores(Iter_T begin, Iter_T end) const
+	{
+		static constexpr auto window_sizes = std::array<size_t, sizeof...(WINDOW_SIZES)>{ WINDOW_SIZES... };
+
+		const auto scores = depth_scores(begin, end, window_sizes);
 
-		return std::accumulate(begin, end, 0, [&window, &prev_score, &current_idx](auto curr, auto next) {
+		auto out = std::array<uint64_t, sizeof...(WINDOW_SIZES)>{};
+		std::copy(scores.begin(), scores.end(), out.begin());
 
-			auto new_score = uint32_t{ prev_score - window[current_idx % window.size()] + next };
+		return out;
+	}
+
+	// As above, with the window sizes chosen at runtime. Contiguous data is scored a block at a time, so each block is read
+	// from memory once and then stays in L1 while every window size is counted over it. Other iterators are read once, with
+	// the last few values kept in a ring buffer.
+	template<typename Iter_T>
+	std::vector<uint64_t> depth_scores(Iter_T begin, Iter_T end, std::span<const size_t> window_sizes) const
+	{
+		_validate_window_sizes(window_sizes);
+
+		if constexpr (std::contiguous_iterator<Iter_T>) {
+			auto out = std::vector<uint64_t>(window_sizes.size());
+			_count_depth_increases(std::span{ begin, end }, 0, static_cast<size_t>(std::distance(begin, end)), window_sizes, out);
+
+			return out;
+		}
+		else {
+			return _stream_depth_scores(begin, end, window_sizes);
+		}
+	}
 
-			auto out = new_score > prev_score ? ++curr : curr;
+	// As above, with the data split into one chunk per pool thread. A chunk compares its first values with the last few of the
+	// chunk before, so the chunk scores simply add up.
+	template<typename Value_T, size_t EXTENT>
+	std::vector<uint64_t> depth_scores(std::span<Value_T, EXTENT> depths, std::span<const size_t> window_sizes, ThreadPool& pool) const
+	{
+		_validate_window_sizes(window_sizes);
 
-			prev_score = new_score;
-			window[current_idx % window.size()] = next;
-			++current_idx;
+		const auto chunk_scores = for_each_chunk(pool, depths.size(), depth_block_size, [depths, window_sizes](size_t chunk_begin, size_t chunk_end) {
+			auto out = std::vector<uint64_t>(window_sizes.size());
+			_count_depth_increases(depths, chunk_begin, chunk_end, window_sizes, out);
 
 			return out;
 			});
+
+		auto out = std::vector<uint64_t>(window_sizes.size());
+		for (const auto& scores : chunk_scores) {
+			std::transform(out.begin(), out.end(), scores.begin(), out.begin(), std::plus<>{});
+		}
+
+		return out;
 	}
 
 	template<typename Iter_T>
@@ -362,11 +1725,99 @@ public:
 		return std::accumulate(begin, end, Aiming{}).to_direction();
 	}
 
+	Direction net_direction(const CourseCommands& course) const
+	{
+		return {
+			std::reduce(course.x().begin(), course.x().end()),
+			std::reduce(course.depth().begin(), course.depth().end())
+		};
+	}
+
+	Direction net_aiming(const CourseCommands& course) const
+	{
+		const auto x = course.x();
+		const auto depth_change = course.depth();
+
+		// The aim is the running total of the depth changes, and each forward move dives by its distance times the aim.
+		auto aim = CourseCommands::Value_t{ 0 };
+		auto depth = CourseCommands::Value_t{ 0 };
+		for (auto idx = CourseCommands::Size_t{ 0 }; idx < course.size(); ++idx) {
+			aim += depth_change[idx];
+			depth += x[idx] * aim;
+		}
+
+		return { std::reduce(x.begin(), x.end()), depth };
+	}
+
+	// The parallel variants need random access iterators.
+	template<typename Iter_T>
+	Direction net_direction(Iter_T begin, Iter_T end, ThreadPool& pool) const
+	{
+		return parallel_transform_reduce(pool, begin, end, Direction{}, std::plus<>{}, std::identity{});
+	}
+
+	template<typename Iter_T>
+	Direction net_aiming(Iter_T begin, Iter_T end, ThreadPool& pool) const
+	{
+		return parallel_transform_reduce(pool, begin, end, Aiming{}, std::plus<>{}, Aiming::from).to_direction();
+	}
+
+	// The position after each command.
+	template<typename Iter_T>
+	std::vector<Direction> track_course(Iter_T begin, Iter_T end) const
+	{
+		auto out = std::vector<Direction>{};
+		std::partial_sum(begin, end, std::back_inserter(out));
+
+		return out;
+	}
+
+	template<typename Iter_T>
+	std::vector<Direction> track_course(Iter_T begin, Iter_T end, ThreadPool& pool) const
+	{
+		auto out = std::vector<Direction>(std::distance(begin, end));
+		parallel_transform_inclusive_scan(pool, begin, end, out.begin(), Direction{}, std::plus<>{}, std::identity{});
+
+		return out;
+	}
+
+	// The position after each command of an aimed course.
+	template<typename Iter_T>
+	std::vector<Direction> track_aimed_course(Iter_T begin, Iter_T end) const
+	{
+		auto out = std::vector<Direction>{};
+
+		auto state = Aiming{};
+		std::transform(begin, end, std::back_inserter(out), [&state](const Direction& d) {
+			state = state + d;
+			return state.to_direction();
+			});
+
+		return out;
+	}
+
+	template<typename Iter_T>
+	std::vector<Direction> track_aimed_course(Iter_T begin, Iter_T end, ThreadPool& pool) const
+	{
+		auto states = std::vector<Aiming>(std::distance(begin, end));
+		parallel_transform_inclusive_scan(pool, begin, end, states.begin(), Aiming{}, std::plus<>{}, Aiming::from);
+
+		auto out = std::vector<Direction>(states.size());
+		std::transform(states.begin(), states.end(), out.begin(), [](const auto& state) { return state.to_direction(); });
+
+		return out;
+	}
+
 	uint32_t power_consumption(const DiagnosticLog& log) const
 	{
 		return LogProcessor::power_consumption(log);
 	}
 
+	uint32_t power_consumption(const DiagnosticStats& stats) const
+	{
+		return LogProcessor::power_consumption(stats);
+	}
+
 	uint32_t life_support_rating(const DiagnosticLog& log) const
 	{
 		return LogProcessor::life_support_rating(log);
@@ -378,12 +1829,95 @@ public:
 		return VentAnalyzer{ data }.score<FORMATIONS>();
 	}
 
+	template<size_t FORMATIONS>
+	uint32_t detect_vents(std::istream& data, ThreadPool& pool) const
+	{
+		return VentAnalyzer{ data }.score<FORMATIONS>(pool);
+	}
+
+	template<size_t FORMATIONS>
+	VentField vent_field(std::istream& data) const
+	{
+		return VentAnalyzer{ data }.field<FORMATIONS>();
+	}
+
+	// The map is scanned as it is read, so it never has to fit in memory.
 	size_t lava_tube_smoke_risk(std::istream& data) const
 	{
-		const auto minima = FloorHeightAnalyser<size_t, 1>{}.load(data).find_minima();
-		return std::accumulate(minima.begin(), minima.end(), size_t{ 0 }, [](auto curr, const auto& next) {
-			return curr + next.z + 1;
-			});
+		auto out = size_t{ 0 };
+		FloorHeightScanner<uint8_t, 1>{}.scan(data, [&out](const auto& minimum) { out += minimum.z + 1; });
+
+		return out;
+	}
+
+	size_t lava_tube_smoke_risk(std::string_view data) const
+	{
+		auto out = size_t{ 0 };
+		FloorHeightScanner<uint8_t, 1>{}.scan(data, [&out](const auto& minimum) { out += minimum.z + 1; });
+
+		return out;
+	}
+
+	size_t largest_basins_product(std::istream& data) const
+	{
+		return FloorHeightAnalyser<uint8_t, 1>{}.load(data).find_basins().largest_product(3);
+	}
+
+private:
+	static constexpr size_t depth_block_size = 4096;
+
+	static void _validate_window_sizes(std::span<const size_t> window_sizes)
+	{
+		if (std::find(window_sizes.begin(), window_sizes.end(), 0) != window_sizes.end()) {
+			throw InvalidArgException("Depth windows need at least one value");
+		}
+	}
+
+	// Adds the increases at positions [begin, end) of the data to out, one count per window size.
+	template<typename Value_T, size_t EXTENT>
+	static void _count_depth_increases(std::span<Value_T, EXTENT> depths, size_t begin, size_t end, std::span<const size_t> window_sizes, std::span<uint64_t> out)
+	{
+		const auto* data = depths.data();
+
+		for (auto block = begin; block < end; block += depth_block_size) {
+			const auto block_end = std::min(end, block + depth_block_size);
+
+			for (size_t w = 0; w < window_sizes.size(); ++w) {
+				const auto window_size = window_sizes[w];
+
+				auto block_count = uint32_t{ 0 };
+				for (auto i = std::max(block, window_size); i < block_end; ++i) {
+					block_count += data[i] > data[i - window_size] ? 1 : 0;
+				}
+
+				out[w] += block_count;
+			}
+		}
+	}
+
+	template<typename Iter_T>
+	static std::vector<uint64_t> _stream_depth_scores(Iter_T begin, Iter_T end, std::span<const size_t> window_sizes)
+	{
+		const auto longest_window = window_sizes.empty() ? size_t{ 0 } : *std::max_element(window_sizes.begin(), window_sizes.end());
+
+		// A power-of-two ring buffer of the most recent values, long enough to reach back over the longest window.
+		auto history = std::vector<std::iter_value_t<Iter_T>>(std::bit_ceil(longest_window + 1));
+		const auto mask = history.size() - 1;
+
+		auto out = std::vector<uint64_t>(window_sizes.size());
+		for (auto idx = size_t{ 0 }; begin != end; ++begin, ++idx) {
+			const auto value = *begin;
+
+			for (size_t w = 0; w < window_sizes.size(); ++w) {
+				if (idx >= window_sizes[w]) {
+					out[w] += value > history[(idx - window_sizes[w]) & mask] ? 1 : 0;
+				}
+			}
+
+			history[idx & mask] = value;
+		}
+
+		return out;
 	}
 };
 
@@ -3,6 +3,7 @@
 #include "Common.hpp"
 #include <Maths/Geometry.hpp>
 #include "StringOperations.hpp"
+#include "Stencil.hpp"
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
@@ -91,10 +92,10 @@ private:
 	void _apply_scaled_grid(Size_t start_row, Size_t start_col, Grid_t& target) const
 	{
 		const auto offset = _offset_from_row_and_col(start_row, start_col);
-		for (auto r = 0u; r < _risk_grid.n_rows; ++r) {
-			const auto target_row = r + start_row;
-			for (auto c = 0u; c < _risk_grid.n_cols; ++c) {
-				target.at(target_row, c + start_col) = _apply_offset(offset, _risk_grid.at(r, c));
+		for (auto c = 0u; c < _risk_grid.n_cols; ++c) {
+			const auto target_col = c + start_col;
+			for (auto r = 0u; r < _risk_grid.n_rows; ++r) {
+				target.at(r + start_row, target_col) = _apply_offset(offset, _risk_grid.at(r, c));
 			}
 		}
 	}
@@ -126,20 +127,14 @@ class CavernPathFinder : boost::noncopyable
 	using VertexDescriptor_t = boost::graph_traits<Graph_t>::vertex_descriptor;
 	using VertexRoute_t = std::vector<VertexDescriptor_t>;
 
-	enum Neighbour
-	{
-		up    = 0b0001,
-		down  = 0b0010,
-		left  = 0b0100,
-		right = 0b1000
-	};
-
 public:
 
 	using Point_t = Point2D<Cavern::Size_t>;
 	using Route_t = std::vector<Point_t>;
 
-	CavernPathFinder& plot_course(const Cavern::Grid_t& risk_grid)
+	// Any grid with n_rows, n_cols, n_elem and at(row, col) will do, e.g. Cavern::Grid_t or a TiledGrid.
+	template<typename Grid_T>
+	CavernPathFinder& plot_course(const Grid_T& risk_grid)
 	{
 		_graph = build_graph(risk_grid);
 _optimal_path = _find_path_via_dijkstra(
@@ -163,68 +158,26 @@ return *this;
 		return out;
 	}
 
-	Graph_t build_graph(const Cavern::Grid_t& risk_grid)
+	template<typename Grid_T>
+	Graph_t build_graph(const Grid_T& risk_grid)
 	{
 		_cavern_rows = risk_grid.n_rows;
 		_cavern_cols = risk_grid.n_cols;
 
 		auto out = Graph_t(risk_grid.n_elem);
 
-		_add_edges<up|down|left|right>(risk_grid, out);	// Bulk edges
-		_add_edges<up|down|     right>(risk_grid, out);	// Left-most column
-		_add_edges<up|down|left      >(risk_grid, out);	// Right-most column
-		_add_edges<   down|left|right>(risk_grid, out);	// Top row
-		_add_edges<up|     left|right>(risk_grid, out);	// Bottom row
-		_add_edges<   down|     right>(risk_grid, out);	// Top-left grid position
-		_add_edges<   down|left      >(risk_grid, out);	// Top-right grid position
-		_add_edges<up|          right>(risk_grid, out);	// Bottom-left grid position
-		_add_edges<up|     left      >(risk_grid, out);	// Bottom-right grid position
-
-		return std::move(out);
-	}
-
-	template<int HAS_NEIGHBOUR>
-	static constexpr int _row_col_offset()
-	{
-		if constexpr (HAS_NEIGHBOUR != 0) {
-			return 1;
-		}
-		else {
-			return 0;
-		}
-	}
-
-	template<int NEIGHBOURS>
-	void _add_edges(const Cavern::Grid_t& risk_grid, Graph_t& graph)
-	{
 		auto vertex_from_row_col = [&risk_grid](auto r, auto c) -> size_t {
 			return r * risk_grid.n_cols + c;
 		};
 
-		const auto row_start = 0u + _row_col_offset<NEIGHBOURS & up>();
-		const auto row_end = risk_grid.n_rows - _row_col_offset<NEIGHBOURS & down>();
-		const auto col_start = 0u + _row_col_offset<NEIGHBOURS & left>();
-		const auto col_end = risk_grid.n_cols - _row_col_offset<NEIGHBOURS & right>();
-
-		// Add bulk edges.
-		for (auto r = row_start; r < row_end; ++r) {
-			for (auto c = col_start; c < col_end; ++c) {
-				const auto v_0 = vertex_from_row_col(r, c);
-
-				if constexpr ((NEIGHBOURS & up) != 0) {
-					boost::add_edge(v_0, vertex_from_row_col(r - 1, c), EdgeWeight_t{ risk_grid.at(r - 1, c) }, graph);
-				}
-				if constexpr ((NEIGHBOURS & down) != 0) {
-					boost::add_edge(v_0, vertex_from_row_col(r + 1, c), EdgeWeight_t{ risk_grid.at(r + 1, c) }, graph);
-				}
-				if constexpr ((NEIGHBOURS & left) != 0) {
-					boost::add_edge(v_0, vertex_from_row_col(r, c - 1), EdgeWeight_t{ risk_grid.at(r, c - 1) }, graph);
-				}
-				if constexpr ((NEIGHBOURS & right) != 0) {
-					boost::add_edge(v_0, vertex_from_row_col(r, c + 1), EdgeWeight_t{ risk_grid.at(r, c + 1) }, graph);
-				}
-			}
-		}
+		stencil::for_each_cell<stencil::FourConnected<>>(risk_grid, [&](auto r, auto c, const auto& neighbours) {
+			const auto v_0 = vertex_from_row_col(r, c);
+			neighbours([&](auto neighbour_r, auto neighbour_c) {
+				boost::add_edge(v_0, vertex_from_row_col(neighbour_r, neighbour_c), EdgeWeight_t{ risk_grid.at(neighbour_r, neighbour_c) }, out);
+				});
+			});
+
+		return std::move(out);
 	}
 
 	Point_t cavern_location_from_vertex(const VertexDescriptor_t& v) const
@@ -43,6 +43,12 @@ public:
 		throw Exception("Failed to read Lanternfish shoal from stream: Value out-of-range");
 	}
 
+	CrabSorter load(std::span<const uint32_t> positions)
+	{
+		_positions.assign(positions.begin(), positions.end());
+		return *this;
+	}
+
 	auto positions() const { return _positions; }
 
 	template<typename FuelBurnFn_T>
@@ -11,133 +11,739 @@ namespace aoc
 
 ///////////////////////////////////////////////////////////////////////////////
 
-class DiagnosticLog
+// A single diagnostic report line, packed into one word. Bits are indexed as they're written, so index 0 is the most
+// significant bit of the entry.
+class DiagnosticEntry
 {
 public:
-	static constexpr uint32_t entry_size = 12;
-	using Entry_t = std::array<bool, entry_size>;
+	using Size_t = uint32_t;
+	using Word_t = uint64_t;
+
+	static constexpr Size_t max_width = std::numeric_limits<Word_t>::digits;
+
+	class BitIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = bool;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = bool;
+
+		BitIterator()
+			: _entry{ nullptr }
+			, _idx{ 0 }
+		{}
+
+		BitIterator(const DiagnosticEntry& entry, Size_t idx)
+			: _entry{ &entry }
+			, _idx{ idx }
+		{}
+
+		reference operator*() const { return (*_entry)[_idx]; }
+
+		BitIterator& operator++()
+		{
+			++_idx;
+			return *this;
+		}
+
+		BitIterator operator++(int)
+		{
+			auto out = *this;
+			++_idx;
+			return out;
+		}
+
+		bool operator==(const BitIterator& other) const { return _idx == other._idx; }
+		bool operator!=(const BitIterator& other) const { return _idx != other._idx; }
+
+	private:
+		const DiagnosticEntry* _entry;
+		Size_t _idx;
+	};
+
+	constexpr DiagnosticEntry()
+		: _bits{ 0 }
+		, _width{ 0 }
+	{}
+
+	constexpr DiagnosticEntry(Word_t bits, Size_t width)
+		: _bits{ bits & mask(width) }
+		, _width{ width }
+	{
+		if (width > max_width) {
+			throw OutOfRangeException(std::format("Diagnostic entries can be at most {} bits wide", max_width));
+		}
+	}
+
+	constexpr DiagnosticEntry(std::initializer_list<bool> bits)
+		: DiagnosticEntry{}
+	{
+		if (bits.size() > max_width) {
+			throw OutOfRangeException(std::format("Diagnostic entries can be at most {} bits wide", max_width));
+		}
+
+		for (const auto bit : bits) {
+			_bits = (_bits << 1) | (bit ? 1 : 0);
+		}
+
+		_width = static_cast<Size_t>(bits.size());
+	}
+
+	// A word with the lowest width bits set.
+	static constexpr Word_t mask(Size_t width) { return width >= max_width ? ~Word_t{ 0 } : (Word_t{ 1 } << width) - 1; }
+
+	constexpr Word_t bits() const { return _bits; }
+	constexpr Size_t size() const { return _width; }
+
+	constexpr bool operator[](Size_t idx) const { return (_bits >> (_width - 1 - idx)) & 1; }
+
+	void set(Size_t idx, bool value)
+	{
+		const auto bit = Word_t{ 1 } << (_width - 1 - idx);
+		_bits = value ? _bits | bit : _bits & ~bit;
+	}
+
+	BitIterator begin() const { return BitIterator{ *this, 0 }; }
+	BitIterator end() const { return BitIterator{ *this, _width }; }
+
+	constexpr bool operator==(const DiagnosticEntry& other) const = default;
 
 private:
-	std::vector<Entry_t> entries;
+	Word_t _bits;
+	Size_t _width;
+};
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Turns text made of fixed-width lines of '0' and '1' into packed words without going through a stream extraction per
+// line. Eight characters at a time are loaded into a word, checked with a single mask-and-compare and collapsed into eight
+// bits with a multiply, so a whole line costs a handful of word operations. That's the SWAR form of a vector compare and
+// movemask: it needs no intrinsics, so the same code serves the Win32 and x64 builds. The width comes from the first line
+// and the parser remembers it, along with the line count, across calls so a stream can be fed through in blocks.
+class DiagnosticParser
+{
 public:
+	using Word_t = DiagnosticEntry::Word_t;
+	using Width_t = DiagnosticEntry::Size_t;
+	using Size_t = size_t;
 
-	using Iterator_t = decltype(entries.begin());
-	using ConstIterator_t = decltype(entries.cbegin());
-	using Size_t = decltype(entries.size());
+	static constexpr Size_t block_size = 1 << 16;
 
-	DiagnosticLog(std::istream& is)
+	DiagnosticParser()
+		: _width{ 0 }
+		, _line{ 0 }
+	{}
+
+	Width_t width() const { return _width; }
+	Size_t line_count() const { return _line; }
+
+	// The bits of a line of '0' and '1' characters, first character most significant, or nothing if there's any other
+	// character in it. Lines longer than a word keep only their last 64 bits.
+	static std::optional<Word_t> parse_bits(std::string_view line)
 	{
-		load(is);
+		auto out = Word_t{ 0 };
+		auto invalid = Word_t{ 0 };
+		auto pos = Size_t{ 0 };
+
+		if constexpr (std::endian::native == std::endian::little) {
+			for (; pos + sizeof(Word_t) <= line.size(); pos += sizeof(Word_t)) {
+				auto chunk = Word_t{};
+				std::memcpy(&chunk, line.data() + pos, sizeof(Word_t));
+
+				// Every byte must be 0x30 or 0x31.
+				invalid |= (chunk & 0xFEFEFEFEFEFEFEFE) ^ 0x3030303030303030;
+
+				// Each byte is now 0 or 1; the multiply gathers them into the top byte, first character highest.
+				out = (out << 8) | (((chunk - 0x3030303030303030) * 0x8040201008040201) >> 56);
+			}
+		}
+
+		for (; pos < line.size(); ++pos) {
+			const auto c = static_cast<Word_t>(static_cast<unsigned char>(line[pos]));
+			invalid |= (c & 0xFE) ^ 0x30;
+			out = (out << 1) | (c & 1);
+		}
+
+		return invalid == 0 ? std::optional{ out } : std::nullopt;
 	}
 
-	DiagnosticLog() {}
+	// Parses each line of the text and passes its word to on_entry. Blank lines are skipped. If is_last is false, a final line
+	// without a newline is left for the next call, and the return value says how much of the text was used.
+	template<typename Fn_T>
+	Size_t parse(std::string_view text, Fn_T on_entry, bool is_last = true)
+	{
+		auto pos = Size_t{ 0 };
+		while (pos < text.size()) {
+			auto end = text.find('\n', pos);
+			if (end == std::string_view::npos) {
+				if (!is_last && text.size() - pos <= DiagnosticEntry::max_width + 1) {
+					break;
+				}
+
+				end = text.size();
+			}
+
+			++_line;
+
+			auto line = text.substr(pos, end - pos);
+			if (!line.empty() && line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+
+			pos = std::min(end + 1, text.size());
 
+			if (line.empty()) {
+				continue;
+			}
 
-	void load(std::istream& is) try
+			on_entry(_parse_line(line));
+		}
+
+		return pos;
+	}
+
+	// Reads the rest of the stream a block at a time. The stream's failbit is set if a line can't be parsed.
+	template<typename Fn_T>
+	void parse(std::istream& is, Fn_T on_entry) try
 	{
-		entries.clear();
+		auto buffer = std::string{};
 
-		using Iter_t = std::istream_iterator<Entry_t>;
-		std::copy(Iter_t(is), Iter_t(), std::back_inserter(entries));
+		while (is) {
+			const auto unparsed = buffer.size();
+			buffer.resize(unparsed + block_size);
+
+			is.read(buffer.data() + unparsed, block_size);
+			buffer.resize(unparsed + static_cast<Size_t>(is.gcount()));
+
+			buffer.erase(0, parse(buffer, on_entry, !is));
+		}
 	}
 	catch (const Exception&)
 	{
-		entries.clear();
+		is.setstate(std::ios::failbit);
 
 		throw;
 	}
 
-	ConstIterator_t begin() const { return entries.begin(); }
-	Iterator_t begin() { return entries.begin(); }
+private:
+	Word_t _parse_line(std::string_view line)
+	{
+		if (_width == 0) {
+			if (line.size() > DiagnosticEntry::max_width) {
+				throw ParseException(std::format("Line {} is {} characters long, but diagnostic entries can be at most {} bits",
+					_line, line.size(), DiagnosticEntry::max_width), _line);
+			}
+
+			_width = static_cast<Width_t>(line.size());
+		}
+
+		if (line.size() != _width) {
+			throw ParseException(std::format("Line {} is {} characters long, but the log's entries are {} bits",
+				_line, line.size(), _width), _line);
+		}
+
+		const auto bits = parse_bits(line);
+		if (!bits) {
+			throw ParseException(std::format("Invalid character in log line {}: {}", _line, line), _line);
+		}
+
+		return *bits;
+	}
+
+	Width_t _width;
+	Size_t _line;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The entries of a diagnostic report. Entries are stored one packed word each, with the width taken from the first line
+// of the report. Alongside them the log keeps a bit-sliced copy: for each bit position, a column of words holding that bit
+// from 64 consecutive entries. Per-bit counts are then popcounts over a column.
+class DiagnosticLog
+{
+public:
+	using Entry_t = DiagnosticEntry;
+	using Word_t = Entry_t::Word_t;
+	using Size_t = size_t;
+
+	static constexpr auto max_entry_width = Entry_t::max_width;
+	static constexpr Size_t entries_per_column_word = std::numeric_limits<Word_t>::digits;
+
+	class ConstIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Entry_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = Entry_t;
+
+		ConstIterator()
+			: _log{ nullptr }
+			, _idx{ 0 }
+		{}
+
+		ConstIterator(const DiagnosticLog& log, Size_t idx)
+			: _log{ &log }
+			, _idx{ idx }
+		{}
+
+		reference operator*() const { return (*_log)[_idx]; }
+
+		ConstIterator& operator++()
+		{
+			++_idx;
+			return *this;
+		}
+
+		ConstIterator operator++(int)
+		{
+			auto out = *this;
+			++_idx;
+			return out;
+		}
+
+		bool operator==(const ConstIterator& other) const { return _idx == other._idx; }
+		bool operator!=(const ConstIterator& other) const { return _idx != other._idx; }
+
+	private:
+		const DiagnosticLog* _log;
+		Size_t _idx;
+	};
+
+	using Iterator_t = ConstIterator;
+	using ConstIterator_t = ConstIterator;
+
+	DiagnosticLog(std::istream& is)
+		: DiagnosticLog{}
+	{
+		load(is);
+	}
+
+	DiagnosticLog()
+		: _width{ 0 }
+	{}
+
+	// Reads the rest of the stream. An invalid line throws a ParseException saying which line it was, and leaves the log
+	// empty.
+	void load(std::istream& is)
+	{
+		_load([&is](DiagnosticParser& parser, auto on_entry) { parser.parse(is, on_entry); });
+	}
+
+	void load(std::string_view text)
+	{
+		_load([text](DiagnosticParser& parser, auto on_entry) { parser.parse(text, on_entry); });
+	}
+
+	// Takes entries that have already been packed, e.g. by the compile-time parser for embedded inputs. Bits above the
+	// width are ignored.
+	void load(std::span<const Word_t> words, Entry_t::Size_t width)
+	{
+		if (width > Entry_t::max_width) {
+			throw OutOfRangeException(std::format("Diagnostic entries can be at most {} bits wide", Entry_t::max_width));
+		}
+
+		_clear();
+
+		_words.reserve(words.size());
+		std::transform(words.begin(), words.end(), std::back_inserter(_words), [width](auto word) { return word & Entry_t::mask(width); });
+
+		_width = width;
+		_slice_columns();
+	}
+
+	ConstIterator_t begin() const { return ConstIterator{ *this, 0 }; }
+	ConstIterator_t end() const { return ConstIterator{ *this, size() }; }
+
+	Size_t size() const { return _words.size(); }
+	Entry_t::Size_t width() const { return _width; }
+
+	Entry_t operator[](Size_t idx) const { return Entry_t(_words[idx], _width); }
+
+	// The packed entries, one word each with the first bit of the entry in the most significant of the lowest width bits.
+	std::span<const Word_t> words() const { return _words; }
+
+	// The bit-sliced view of a bit position: bit j of word k is that bit of entry 64k + j.
+	std::span<const Word_t> column(Entry_t::Size_t bit) const
+	{
+		if (bit >= _width) {
+			throw OutOfRangeException(std::format("Bit {} is out of range for {}-bit entries", bit, _width));
+		}
+
+		return std::span{ _columns }.subspan(bit * _column_size(), _column_size());
+	}
 
-	ConstIterator_t end() const { return entries.end(); }
-	Iterator_t end() { return entries.end(); }
+	// How many entries have the given bit set.
+	Size_t count_ones(Entry_t::Size_t bit) const
+	{
+		const auto col = column(bit);
 
-	Size_t size() const { return entries.size(); }
+		// Each word holds the bit for 64 entries, so this is one popcount per 64 entries.
+		return std::accumulate(col.begin(), col.end(), Size_t{ 0 }, [](auto curr, auto word) {
+			return curr + static_cast<Size_t>(std::popcount(word));
+			});
+	}
 
 	Entry_t get_most_frequent_bits() const
 	{
-		return most_frequent_bits(begin(), end());
+		return _select_bits([n = size()](auto ones) { return 2 * ones >= n; });
 	}
 
 	template<typename LogEntryIter_T>
 	static Entry_t most_frequent_bits(LogEntryIter_T begin, LogEntryIter_T end)
 	{
-		auto bit_counts = bit_balance(begin, end);
-		return create_most_common_bits(std::move(bit_counts));
+		return create_most_common_bits(bit_balance(begin, end));
 	}
 
 	Entry_t get_least_frequent_bits() const
 	{
-		return least_frequent_bits(begin(), end());
+		return _select_bits([n = size()](auto ones) { return 2 * ones < n; });
 	}
 
 	template<typename LogEntryIter_T>
 	static Entry_t least_frequent_bits(LogEntryIter_T begin, LogEntryIter_T end)
 	{
-		auto bit_counts = bit_balance(begin, end);
-		return create_least_common_bits(std::move(bit_counts));
+		return create_least_common_bits(bit_balance(begin, end));
 	}
 
 	template<typename Out_T>
 	static Out_T entry_as(const Entry_t& entry)
 	{
-		return std::accumulate(entry.begin(), entry.end(), Out_T{ 0 }, [](auto curr, auto next) {
-			curr <<= 1;
-			if (next)
-				curr |= 1;
-
-			return curr;
-			});
+		return static_cast<Out_T>(entry.bits());
 	}
 
 	template<typename Out_T>
 	static Out_T flipped_entry_as(const Entry_t& entry)
 	{
-		return std::accumulate(entry.begin(), entry.end(), Out_T{ 0 }, [](auto curr, auto next) {
-			curr <<= 1;
-			if (!next)
-				curr |= 1;
-
-			return curr;
-			});
+		return static_cast<Out_T>(~entry.bits() & Entry_t::mask(entry.size()));
 	}
 
 private:
 	template<typename LogEntryIter_T>
-	static std::array<int, aoc::DiagnosticLog::entry_size> bit_balance(LogEntryIter_T begin, LogEntryIter_T end)
+	static std::vector<int> bit_balance(LogEntryIter_T begin, LogEntryIter_T end)
 	{
-		return std::accumulate(begin, end, std::array<int, aoc::DiagnosticLog::entry_size>{},
-			[](auto&& curr, auto&& entry) {
-				std::transform(curr.begin(), curr.end(), entry.begin(), curr.begin(),
-					[](auto count, auto bit) {
-						return count + (bit ? 1 : -1);
-					});
+		auto out = std::vector<int>{};
 
-				return curr;
+		std::for_each(begin, end, [&out](const Entry_t& entry) {
+			out.resize(entry.size());
+			for (auto bit = Entry_t::Size_t{ 0 }; bit < entry.size(); ++bit) {
+				out[bit] += entry[bit] ? 1 : -1;
+			}
 			});
+
+		return out;
 	}
 
-	static Entry_t create_most_common_bits(std::array<int, aoc::DiagnosticLog::entry_size>&& counts)
+	static Entry_t create_most_common_bits(const std::vector<int>& counts)
 	{
-		auto out = Entry_t{};
-		std::transform(counts.begin(), counts.end(), out.begin(), [](auto count) {
-			return count >= 0 ? true : false;
-			});
+		auto out = Entry_t(0, static_cast<Entry_t::Size_t>(counts.size()));
+		for (auto bit = Entry_t::Size_t{ 0 }; bit < out.size(); ++bit) {
+			out.set(bit, counts[bit] >= 0);
+		}
 
 		return out;
 	}
 
-	static Entry_t create_least_common_bits(std::array<int, aoc::DiagnosticLog::entry_size>&& counts)
+	static Entry_t create_least_common_bits(const std::vector<int>& counts)
 	{
-		auto out = Entry_t{};
-		std::transform(counts.begin(), counts.end(), out.begin(), [](auto count) {
-			return count >= 0 ? false : true;
-			});
+		auto out = Entry_t(0, static_cast<Entry_t::Size_t>(counts.size()));
+		for (auto bit = Entry_t::Size_t{ 0 }; bit < out.size(); ++bit) {
+			out.set(bit, counts[bit] < 0);
+		}
+
+		return out;
+	}
+
+	template<typename Pred_T>
+	Entry_t _select_bits(Pred_T is_set) const
+	{
+		auto out = Entry_t(0, _width);
+		for (auto bit = Entry_t::Size_t{ 0 }; bit < _width; ++bit) {
+			out.set(bit, is_set(count_ones(bit)));
+		}
 
 		return out;
 	}
+
+	Size_t _column_size() const { return (_words.size() + entries_per_column_word - 1) / entries_per_column_word; }
+
+	void _slice_columns()
+	{
+		const auto column_size = _column_size();
+		_columns.assign(_width * column_size, 0);
+
+		for (Size_t idx = 0; idx < _words.size(); ++idx) {
+			const auto entry_bit = Word_t{ 1 } << (idx % entries_per_column_word);
+			const auto col_word = idx / entries_per_column_word;
+
+			for (auto bits = _words[idx]; bits != 0; bits &= bits - 1) {
+				const auto bit = _width - 1 - static_cast<Entry_t::Size_t>(std::countr_zero(bits));
+				_columns[bit * column_size + col_word] |= entry_bit;
+			}
+		}
+	}
+
+	template<typename Parse_T>
+	void _load(Parse_T parse) try
+	{
+		_clear();
+
+		auto parser = DiagnosticParser{};
+		parse(parser, [this](auto word) { _words.push_back(word); });
+
+		_width = parser.width();
+		_slice_columns();
+	}
+	catch (const Exception&)
+	{
+		_clear();
+
+		throw;
+	}
+
+	void _clear()
+	{
+		_words.clear();
+		_columns.clear();
+		_width = 0;
+	}
+
+	std::vector<Word_t> _words;
+	std::vector<Word_t> _columns;
+	Entry_t::Size_t _width;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Running per-bit counts over a stream of diagnostic entries, for reports too long to hold in a DiagnosticLog. Memory use
+// doesn't depend on the number of entries, and the most and least frequent bits are available at any point. Stats
+// gathered separately, e.g. by readers working on different parts of a feed, are combined with merge().
+class DiagnosticStats
+{
+public:
+	using Entry_t = DiagnosticEntry;
+	using Width_t = Entry_t::Size_t;
+	using Count_t = uint64_t;
+
+	explicit DiagnosticStats(Width_t width = 0)
+		: _width{ width }
+		, _count{ 0 }
+		, _ones{}
+	{
+		if (width > Entry_t::max_width) {
+			throw OutOfRangeException(std::format("Diagnostic entries can be at most {} bits wide", Entry_t::max_width));
+		}
+	}
+
+	// Adds an entry. Stats created without a width take the width of the first entry.
+	void add(const Entry_t& entry)
+	{
+		_adopt_width(entry.size());
+
+		++_count;
+		for (auto bits = entry.bits(); bits != 0; bits &= bits - 1) {
+			++_ones[_width - 1 - std::countr_zero(bits)];
+		}
+	}
+
+	// Adds every entry remaining in the stream, a block at a time. Entries read before an invalid line are kept.
+	void add(std::istream& is)
+	{
+		auto parser = DiagnosticParser{};
+		parser.parse(is, [this, &parser](auto word) { add(Entry_t(word, parser.width())); });
+	}
+
+	void merge(const DiagnosticStats& other)
+	{
+		if (other._count == 0) {
+			return;
+		}
+
+		_adopt_width(other._width);
+
+		_count += other._count;
+		std::transform(_ones.begin(), _ones.end(), other._ones.begin(), _ones.begin(), std::plus<>{});
+	}
+
+	Count_t size() const { return _count; }
+	Width_t width() const { return _width; }
+
+	Count_t count_ones(Width_t bit) const
+	{
+		if (bit >= _width) {
+			throw OutOfRangeException(std::format("Bit {} is out of range for {}-bit entries", bit, _width));
+		}
+
+		return _ones[bit];
+	}
+
+	Entry_t get_most_frequent_bits() const
+	{
+		return _select_bits([n = _count](auto ones) { return 2 * ones >= n; });
+	}
+
+	Entry_t get_least_frequent_bits() const
+	{
+		return _select_bits([n = _count](auto ones) { return 2 * ones < n; });
+	}
+
+private:
+	void _adopt_width(Width_t width)
+	{
+		if (_count == 0 && _width == 0) {
+			_width = width;
+		}
+
+		if (width != _width) {
+			throw InvalidArgException(std::format("Entry is {} bits wide but the stats are for {}-bit entries", width, _width));
+		}
+	}
+
+	template<typename Pred_T>
+	Entry_t _select_bits(Pred_T is_set) const
+	{
+		auto out = Entry_t(0, _width);
+		for (auto bit = Width_t{ 0 }; bit < _width; ++bit) {
+			out.set(bit, is_set(_ones[bit]));
+		}
+
+		return out;
+	}
+
+	Width_t _width;
+	Count_t _count;
+	std::array<Count_t, Entry_t::max_width> _ones;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A binary trie over diagnostic entries, most significant bit first, where every node counts the entries below it. Walking
+// down it answers "how many of the remaining entries have a 0 or a 1 next" in constant time per level, so filtering the
+// entries one bit position at a time costs O(width) rather than a pass over the entries per bit. Entries can be added at
+// any time.
+class DiagnosticTrie
+{
+public:
+	using Entry_t = DiagnosticEntry;
+	using Width_t = Entry_t::Size_t;
+	using Size_t = size_t;
+
+	explicit DiagnosticTrie(Width_t width = 0)
+		: _width{ width }
+		, _nodes(1)
+	{
+		if (width > Entry_t::max_width) {
+			throw OutOfRangeException(std::format("Diagnostic entries can be at most {} bits wide", Entry_t::max_width));
+		}
+	}
+
+	explicit DiagnosticTrie(const DiagnosticLog& log)
+		: DiagnosticTrie{ log.width() }
+	{
+		for (const auto word : log.words()) {
+			_insert(word);
+		}
+	}
+
+	// Adds an entry. An empty trie created without a width takes the width of the first entry.
+	void insert(const Entry_t& entry)
+	{
+		if (size() == 0 && _width == 0) {
+			_width = entry.size();
+		}
+
+		if (entry.size() != _width) {
+			throw InvalidArgException(std::format("Entry is {} bits wide but the trie holds {}-bit entries", entry.size(), _width));
+		}
+
+		_insert(entry.bits());
+	}
+
+	Size_t size() const { return _nodes.front().count; }
+	Width_t width() const { return _width; }
+
+	// The number of entries that start with the bits of the prefix.
+	Size_t count_with_prefix(const Entry_t& prefix) const
+	{
+		if (prefix.size() > _width) {
+			throw InvalidArgException(std::format("A {}-bit prefix is longer than the trie's {}-bit entries", prefix.size(), _width));
+		}
+
+		auto node = Index_t{ 0 };
+		for (auto bit = Width_t{ 0 }; bit < prefix.size(); ++bit) {
+			node = _nodes[node].children[prefix[bit]];
+			if (node == no_node) {
+				return 0;
+			}
+		}
+
+		return _nodes[node].count;
+	}
+
+	// Follows the trie from the root, picking the next bit with choose_one(zeros, ones) wherever both branches have entries,
+	// and returns the entry it ends on. This is the bit criteria filter of the life support ratings.
+	template<typename BitSelector_T>
+	Entry_t select(BitSelector_T choose_one) const
+	{
+		if (size() == 0) {
+			throw Exception("Cannot select an entry from an empty trie");
+		}
+
+		auto out = Entry_t(0, _width);
+
+		auto node = Index_t{ 0 };
+		for (auto bit = Width_t{ 0 }; bit < _width; ++bit) {
+			const auto& children = _nodes[node].children;
+			const auto zeros = _count(children[0]);
+			const auto ones = _count(children[1]);
+
+			const auto is_one = zeros == 0 || (ones != 0 && choose_one(zeros, ones));
+
+			out.set(bit, is_one);
+			node = children[is_one ? 1 : 0];
+		}
+
+		return out;
+	}
+
+private:
+	using Index_t = uint32_t;
+
+	static constexpr Index_t no_node = 0;
+
+	struct Node
+	{
+		std::array<Index_t, 2> children{ no_node, no_node };
+		Size_t count{ 0 };
+	};
+
+	Size_t _count(Index_t node) const { return node == no_node ? 0 : _nodes[node].count; }
+
+	void _insert(Entry_t::Word_t word)
+	{
+		auto node = Index_t{ 0 };
+		++_nodes[node].count;
+
+		for (auto bit = _width; bit > 0; --bit) {
+			const auto branch = (word >> (bit - 1)) & 1;
+
+			if (_nodes[node].children[branch] == no_node) {
+				_nodes[node].children[branch] = static_cast<Index_t>(_nodes.size());
+				_nodes.emplace_back();
+			}
+
+			node = _nodes[node].children[branch];
+			++_nodes[node].count;
+		}
+	}
+
+	Width_t _width;
+
+	// The root is always the first node, so no child ever refers to index 0.
+	std::vector<Node> _nodes;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -164,29 +770,19 @@ inline istream & operator>>(istream & is, aoc::DiagnosticLog::Entry_t & entry)
 		return is;
 	}
 
-	if (param_str.length() != aoc::DiagnosticLog::entry_size) {
+	if (param_str.length() > aoc::DiagnosticLog::max_entry_width) {
 		is.setstate(std::ios::failbit);
 		throw aoc::Exception(std::format("Invalid log line: {}", param_str));
 	}
 
-	try {
-		std::transform(param_str.begin(), param_str.end(), entry.begin(),
-			[](auto c) {
-				switch (c)
-				{
-				case '0': return false;
-				case '1': return true;
-				default:
-					throw aoc::Exception(std::format("Invalid character in log line: {}", c));
-				}
-			});
-	}
-	catch (const aoc::Exception&)
-	{
+	const auto bits = aoc::DiagnosticParser::parse_bits(param_str);
+	if (!bits) {
 		is.setstate(std::ios::failbit);
-		throw;
+		throw aoc::Exception(std::format("Invalid character in log line: {}", param_str));
 	}
 
+	entry = aoc::DiagnosticLog::Entry_t(*bits, static_cast<aoc::DiagnosticEntry::Size_t>(param_str.length()));
+
 	return is;
 }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "FixedGrid.hpp"
+#include "Stencil.hpp"
+
 namespace aoc
 {
 
@@ -10,12 +13,19 @@ inline void print_grid(const arma::Mat<int>& grid)
 	Logger::WriteMessage(std::format("{}\n", ss.str()).c_str());
 }
 
+template<size_t ROWS, size_t COLS>
+inline void print_grid(const FixedGrid<int, ROWS, COLS>& grid)
+{
+	print_grid(grid.as_matrix());
+}
+
 template<arma::uword GRID_SIZE>
 class DumboOctopusModel
 {
-	arma::Mat<int> _octopus;
-	arma::Mat<int> _flash_grid;
-	arma::Mat<int> _flash_mask;
+	using Stencil_t = stencil::EightConnected<>;
+	using Grid_t = FixedGrid<int, GRID_SIZE>;
+
+	Grid_t _octopus;
 
 	static int _char_to_digit(char c)
 	{
@@ -25,8 +35,8 @@ class DumboOctopusModel
 	template<typename Fn_T>
 	void _apply_to_grid(Fn_T fn)
 	{
-		for (auto r = 0; r < GRID_SIZE; ++r) {
-			for (auto c = 0; c < GRID_SIZE; ++c) {
+		for (arma::uword r = 0; r < GRID_SIZE; ++r) {
+			for (arma::uword c = 0; c < GRID_SIZE; ++c) {
 				_octopus.at(r, c) = fn(r, c);
 			}
 		}
@@ -36,17 +46,16 @@ class DumboOctopusModel
 	{
 		auto flashes = int{ 0 };
 
-		for (auto r = 1; r < GRID_SIZE + 1; ++r) {
-			for (auto c = 1; c < GRID_SIZE + 1; ++c) {
-				if (_flash_grid.at(r, c) > flash_threshold) {
-					_flash_grid.at(r, c) = std::numeric_limits<int>::min();
+		stencil::for_each_cell<Stencil_t>(_octopus, [this, &flashes](auto r, auto c, const auto& neighbours) {
+			if (_octopus.at(r, c) <= flash_threshold) {
+				return;
+			}
 
-					_flash_grid.submat(r - 1, c - 1, r + 1, c + 1) += _flash_mask;
+			_octopus.at(r, c) = std::numeric_limits<int>::min();
+			neighbours([this](auto neighbour_r, auto neighbour_c) { ++_octopus.at(neighbour_r, neighbour_c); });
 
-					++flashes;
-				}
-			}
-		}
+			++flashes;
+			});
 
 		return flashes;
 	}
@@ -54,7 +63,6 @@ class DumboOctopusModel
 	int _process_all_flashes()
 	{
 		auto flashes = int{ 0 };
-		_flash_grid.submat(1, 1, GRID_SIZE, GRID_SIZE) = _octopus;
 
 		while (true) {
 			const auto flashes_this_pass = _single_pass_flash();
@@ -70,13 +78,7 @@ class DumboOctopusModel
 
 	void _reset_octopus_that_flashed()
 	{
-		for (auto r = 1; r < GRID_SIZE + 1; ++r) {
-			for (auto c = 1; c < GRID_SIZE + 1; ++c) {
-				if (_flash_grid.at(r, c) < 0) {
-					_flash_grid.at(r, c) = reset_energy_value;
-				}
-			}
-		}
+		std::replace_if(_octopus.begin(), _octopus.end(), [](auto energy) { return energy < 0; }, reset_energy_value);
 	}
 
 public:
@@ -85,28 +87,13 @@ public:
 	static constexpr int reset_energy_value = 0;
 
 	DumboOctopusModel()
-		: _octopus( GRID_SIZE, GRID_SIZE )
-		, _flash_grid(GRID_SIZE + 2, GRID_SIZE + 2)
-		, _flash_mask(3, 3)
-	{
-		_flash_grid.fill(0);
-
-		_flash_mask.fill(1);
-		_flash_mask.at(1, 1) = 0;
-	}
+		: _octopus{ 0 }
+	{}
 
 	template<typename Container_T>
 	DumboOctopusModel(const Container_T& initial_state)
-		: _octopus(GRID_SIZE, GRID_SIZE)
-		, _flash_grid(GRID_SIZE + 2, GRID_SIZE + 2)
-		, _flash_mask(3, 3)
 	{
 		_apply_to_grid([&initial_state](auto r, auto c) {return initial_state[r][c]; });
-
-		_flash_grid.fill(0);
-
-		_flash_mask.fill(1);
-		_flash_mask.at(1, 1) = 0;
 	}
 
 	DumboOctopusModel(const DumboOctopusModel&) = default;
@@ -115,7 +102,7 @@ public:
 	DumboOctopusModel(DumboOctopusModel&&) = default;
 	DumboOctopusModel& operator=(DumboOctopusModel&&) = default;
 
-	const arma::Mat<int>& state() const { return _octopus; }
+	const Grid_t& state() const { return _octopus; }
 
 	DumboOctopusModel& load(std::istream& is)
 	{
@@ -144,8 +131,6 @@ public:
 
 		_reset_octopus_that_flashed();
 
-		_octopus = _flash_grid.submat(1, 1, GRID_SIZE, GRID_SIZE);
-
 		return flashes;
 	}
 
@@ -0,0 +1,232 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <string_view>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+namespace embedded
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// constexpr parsers for the simple puzzle input formats, so inputs compiled into the binary can be turned into arrays at
+// compile time. Invalid input throws IOException, which makes a compile-time evaluation fail to compile.
+
+using Size_t = size_t;
+
+constexpr bool is_line_end(char c) { return c == '\n' || c == '\r'; }
+
+// The number of non-empty lines.
+constexpr Size_t count_lines(std::string_view text)
+{
+	auto out = Size_t{ 0 };
+	auto in_line = false;
+
+	for (const auto c : text) {
+		if (is_line_end(c)) {
+			in_line = false;
+		}
+		else if (!in_line) {
+			in_line = true;
+			++out;
+		}
+	}
+
+	return out;
+}
+
+// The length of the first line.
+constexpr Size_t line_width(std::string_view text)
+{
+	auto out = Size_t{ 0 };
+	while (out < text.size() && !is_line_end(text[out])) {
+		++out;
+	}
+
+	return out;
+}
+
+// The number of separator-delimited fields on the first line.
+constexpr Size_t count_fields(std::string_view text, char separator = ',')
+{
+	const auto line = text.substr(0, line_width(text));
+	if (line.empty()) {
+		return 0;
+	}
+
+	auto out = Size_t{ 1 };
+	for (const auto c : line) {
+		out += c == separator ? 1 : 0;
+	}
+
+	return out;
+}
+
+template<typename Value_T>
+constexpr Value_T parse_unsigned(std::string_view digits)
+{
+	if (digits.empty()) {
+		throw IOException("Expected a number but found nothing");
+	}
+
+	auto out = Value_T{ 0 };
+	for (const auto c : digits) {
+		if (c < '0' || c > '9') {
+			throw IOException("Non-numeric character in number");
+		}
+
+		out = static_cast<Value_T>(out * 10 + static_cast<Value_T>(c - '0'));
+	}
+
+	return out;
+}
+
+// One unsigned decimal value per non-empty line, e.g. the Day 1 depths.
+template<Size_t N, typename Value_T = uint32_t>
+constexpr std::array<Value_T, N> parse_lines(std::string_view text)
+{
+	auto out = std::array<Value_T, N>{};
+	auto idx = Size_t{ 0 };
+
+	for (Size_t pos = 0; pos < text.size();) {
+		auto end = pos;
+		while (end < text.size() && !is_line_end(text[end])) {
+			++end;
+		}
+
+		if (end != pos) {
+			if (idx == N) {
+				throw IOException("More lines than expected");
+			}
+
+			out[idx++] = parse_unsigned<Value_T>(text.substr(pos, end - pos));
+		}
+
+		pos = end + 1;
+	}
+
+	if (idx != N) {
+		throw IOException("Fewer lines than expected");
+	}
+
+	return out;
+}
+
+// A single line of separator-delimited unsigned values, e.g. the Day 6 timers and Day 7 positions.
+template<Size_t N, typename Value_T = uint32_t>
+constexpr std::array<Value_T, N> parse_list(std::string_view text, char separator = ',')
+{
+	const auto line = text.substr(0, line_width(text));
+
+	auto out = std::array<Value_T, N>{};
+	auto idx = Size_t{ 0 };
+
+	for (Size_t pos = 0; pos <= line.size();) {
+		auto end = pos;
+		while (end < line.size() && line[end] != separator) {
+			++end;
+		}
+
+		if (idx == N) {
+			throw IOException("More values than expected");
+		}
+
+		out[idx++] = parse_unsigned<Value_T>(line.substr(pos, end - pos));
+		pos = end + 1;
+	}
+
+	if (idx != N) {
+		throw IOException("Fewer values than expected");
+	}
+
+	return out;
+}
+
+// One fixed-width binary number per non-empty line, e.g. the Day 3 diagnostic entries. The first character is the most
+// significant bit.
+template<Size_t N>
+constexpr std::array<uint64_t, N> parse_binary_lines(std::string_view text)
+{
+	const auto width = line_width(text);
+	if (width == 0 || width > 64) {
+		throw IOException("Binary entries must be between 1 and 64 bits wide");
+	}
+
+	auto out = std::array<uint64_t, N>{};
+	auto idx = Size_t{ 0 };
+
+	for (Size_t pos = 0; pos < text.size();) {
+		auto end = pos;
+		while (end < text.size() && !is_line_end(text[end])) {
+			++end;
+		}
+
+		if (end != pos) {
+			if (end - pos != width) {
+				throw IOException("Binary entries have different widths");
+			}
+
+			if (idx == N) {
+				throw IOException("More lines than expected");
+			}
+
+			auto value = uint64_t{ 0 };
+			for (auto c : text.substr(pos, width)) {
+				if (c != '0' && c != '1') {
+					throw IOException("Non-binary character in entry");
+				}
+
+				value = (value << 1) | static_cast<uint64_t>(c - '0');
+			}
+
+			out[idx++] = value;
+		}
+
+		pos = end + 1;
+	}
+
+	if (idx != N) {
+		throw IOException("Fewer lines than expected");
+	}
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: embedded
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Built with /p:AocEmbedInputs=true, the inputs in Data/ are compiled in (see embed_inputs.py) and the simple ones are
+// parsed at compile time.
+#if defined(AOC_EMBEDDED_INPUTS)
+
+#include "EmbeddedData.generated.hpp"
+
+namespace aoc
+{
+namespace embedded
+{
+
+inline constexpr auto day1_depths = parse_lines<count_lines(data::day1_input)>(data::day1_input);
+
+inline constexpr auto day3_entry_width = line_width(data::day3_input);
+inline constexpr auto day3_entries = parse_binary_lines<count_lines(data::day3_input)>(data::day3_input);
+
+inline constexpr auto day6_list = parse_list<count_fields(data::day6_input)>(data::day6_input);
+inline constexpr auto day7_list = parse_list<count_fields(data::day7_input)>(data::day7_input);
+
+}	// namespace: embedded
+}	// namespace: aoc
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
@@ -3,6 +3,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "StringOperations.hpp"
+#include "FixedGrid.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -66,22 +67,79 @@ public:
 		bool is_marked{ false };
 	};
 
+	static constexpr uint8_t max_size = 5;
+
+	// Visits the cells in use, in column-major order.
+	class CellIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Cell;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Cell*;
+		using reference = const Cell&;
+
+		CellIterator()
+			: _board{ nullptr }
+			, _idx{ 0 }
+		{}
+
+		CellIterator(const Board& board, size_t idx)
+			: _board{ &board }
+			, _idx{ idx }
+		{}
+
+		reference operator*() const { return _board->_numbers.at(_idx % _board->_size, _idx / _board->_size); }
+		pointer operator->() const { return &**this; }
+
+		CellIterator& operator++()
+		{
+			++_idx;
+			return *this;
+		}
+
+		CellIterator operator++(int)
+		{
+			auto out = *this;
+			++_idx;
+			return out;
+		}
+
+		bool operator==(const CellIterator& other) const { return _idx == other._idx; }
+		bool operator!=(const CellIterator& other) const { return _idx != other._idx; }
+
+	private:
+		const Board* _board;
+		size_t _idx;
+	};
+
 	Board(Id_t id, uint8_t size)
 		: _id{ id }
-		, _numbers{ size, size }
-	{}
+		, _size{ size }
+	{
+		if (size > max_size) {
+			throw InvalidArgException(std::format("Bingo boards can be at most {0}x{0}, not {1}x{1}", max_size, size));
+		}
+
+		_cell_of_value.fill(no_cell);
+	}
 
 	Board(const Board&) = default;
 	Board& operator=(const Board&) = default;
 
 	const Id_t& id() const { return _id; }
 
-	auto begin() const { return _numbers.begin(); }
-	auto end() const { return _numbers.end(); }
+	CellIterator begin() const { return { *this, 0 }; }
+	CellIterator end() const { return { *this, size_t{ _size } * _size }; }
 
 	Board& load(std::istream& stream)
 	{
-		for (auto row = 0; row < _numbers.n_rows && stream.good(); ++row) {
+		_cell_of_value.fill(no_cell);
+		_row_marks.fill(0);
+		_column_marks.fill(0);
+		_has_won = false;
+
+		for (auto row = 0; row < _size && stream.good(); ++row) {
 			if (!stream.good()) {
 				throw Exception("Invalid bingo board size board");
 			}
@@ -92,85 +150,36 @@ public:
 		return *this;
 	}
 
+	// Looks the number up in the board's table of cells and counts the mark against the cell's row and column, so the board
+	// knows it has won as soon as one of them is complete.
 	bool mark(uint8_t number)
 	{
-		auto cell = _find(number);
-		if (!cell)
+		const auto cell_idx = _cell_of_value[number];
+		if (cell_idx == no_cell)
 			return false;
 
-		cell->is_marked = true;
+		const auto row = cell_idx % _size;
+		const auto col = cell_idx / _size;
 
-		return true;
-	}
-
-	State_t state() const
-	{
-		if (_have_row_win()) {
-			return State_t::win;
-		}
-
-		if (_have_column_win()) {
-			return State_t::win;
-		}
-
-		return State_t::no_win;
-	}
+		auto& cell = _numbers.at(row, col);
+		if (cell.is_marked)
+			return true;
 
-private:
-
-	bool _have_row_win() const
-	{
-		for (auto row = 0; row < _numbers.n_rows; ++row) {
-			if (_is_winning_row(row))
-				return true;
-		}
-
-		return false;
-	}
-	
-	bool _is_winning_row(size_t row_idx) const
-	{
-		const auto row = _numbers.row(row_idx);
-		for (size_t cell_idx = 0; cell_idx < row.n_elem; ++cell_idx) {
-			if (!row[cell_idx].is_marked)
-				return false;
-		}
+		cell.is_marked = true;
+		_has_won |= ++_row_marks[row] == _size;
+		_has_won |= ++_column_marks[col] == _size;
 
 		return true;
 	}
 
-	bool _have_column_win() const
-	{
-		for (auto col = 0; col < _numbers.n_cols; ++col) {
-			if (_is_winning_column(col))
-				return true;
-		}
-
-		return false;
-	}
-
-	bool _is_winning_column(size_t col_idx) const
+	State_t state() const
 	{
-		const auto col = _numbers.col(col_idx);
-		for (size_t cell_idx = 0; cell_idx < col.n_elem; ++cell_idx) {
-			if (!col[cell_idx].is_marked)
-				return false;
-		}
-
-		return true;
+		return _has_won ? State_t::win : State_t::no_win;
 	}
 
-	const Cell* _find(uint8_t number) const
-	{
-		for (const auto& cell : _numbers) {
-			if (cell.value == number)
-				return &cell;
-		}
-
-		return nullptr;
-	}
+private:
 
-	Cell* _find(uint8_t number) { return const_cast<Cell*>(const_cast<const Board*>(this)->_find(number)); }
+	static constexpr uint8_t no_cell = std::numeric_limits<uint8_t>::max();
 
 	static Cell _string_to_cell(const std::string& str)
 	{
@@ -187,18 +196,31 @@ private:
 		std::getline(stream, line);
 
 		const auto value_strings = split(line, ' ', SplitBehaviour::drop_empty);
-		if (value_strings.size() != _numbers.n_cols) {
+		if (value_strings.size() != _size) {
 			throw Exception("Invalid bingo board size board");
 		}
 
-		auto row = _numbers.row(row_idx);
-		for (size_t idx = 0; idx < row.n_elem; ++idx) {
-			row[idx] = _string_to_cell(value_strings[idx]);
+		for (size_t idx = 0; idx < _size; ++idx) {
+			const auto cell = _string_to_cell(value_strings[idx]);
+			_numbers.at(row_idx, idx) = cell;
+
+			// A number on the board twice is marked where it comes first in column-major order.
+			const auto cell_idx = static_cast<uint8_t>(idx * _size + row_idx);
+			auto& entry = _cell_of_value[cell.value];
+			entry = std::min(entry, cell_idx);
 		}
 	}
 
 	Id_t _id;
-	arma::field<Cell> _numbers;
+	uint8_t _size;
+	FixedGrid<Cell, max_size> _numbers;
+
+	// The column-major index of the cell holding each value, or no_cell, and the number of marked cells in each row and
+	// column.
+	std::array<uint8_t, std::numeric_limits<uint8_t>::max() + 1> _cell_of_value{};
+	std::array<uint8_t, max_size> _row_marks{};
+	std::array<uint8_t, max_size> _column_marks{};
+	bool _has_won{ false };
 };
 
 class Player
@@ -380,7 +402,7 @@ private:
 
 	void _load_board(const Board::Id_t& id, std::istream& stream)
 	{
-		auto board = Board{ id, 5 };
+		auto board = Board{ id, Board::max_size };
 		board.load(stream);
 		_boards.push_back(std::move(board));
 	}
@@ -33,6 +33,23 @@ struct IOException : public Exception, public std::invalid_argument
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// An input that couldn't be parsed, along with the (1-based) line it went wrong on.
+struct ParseException : public IOException
+{
+	ParseException(const std::string& msg, size_t line) : IOException{ msg }, line_number{ line } {}
+
+	size_t line_number;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct CancelledException : public Exception
+{
+	CancelledException(const std::string& msg) : Exception{ msg } {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 }
 
 ///////////////////////////////////////////////////////////////////////////////
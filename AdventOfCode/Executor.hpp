@@ -0,0 +1,275 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The receiving end of a CancellationSource. A default-constructed token can never be cancelled.
+class CancellationToken
+{
+public:
+	CancellationToken() {}
+
+	bool is_cancelled() const { return _flag && _flag->load(); }
+
+	void throw_if_cancelled() const
+	{
+		if (is_cancelled()) {
+			throw CancelledException("Operation was cancelled");
+		}
+	}
+
+private:
+	friend class CancellationSource;
+
+	explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> flag)
+		: _flag{ std::move(flag) }
+	{}
+
+	std::shared_ptr<const std::atomic<bool>> _flag;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+class CancellationSource
+{
+public:
+	CancellationSource()
+		: _flag{ std::make_shared<std::atomic<bool>>(false) }
+	{}
+
+	CancellationToken token() const { return CancellationToken{ _flag }; }
+
+	void cancel() { _flag->store(true); }
+	bool is_cancelled() const { return _flag->load(); }
+
+private:
+	std::shared_ptr<std::atomic<bool>> _flag;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A fixed set of worker threads pulling from one task queue. Tasks still queued when the pool is destroyed are run before
+// the workers exit, so every future handed out is eventually satisfied.
+class ThreadPool : boost::noncopyable
+{
+public:
+	using Size_t = size_t;
+
+	explicit ThreadPool(Size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u))
+		: _is_stopping{ false }
+	{
+		if (thread_count == 0) {
+			throw InvalidArgException("A thread pool needs at least one thread");
+		}
+
+		_threads.reserve(thread_count);
+		for (Size_t i = 0; i < thread_count; ++i) {
+			_threads.emplace_back([this]() { _run_worker(); });
+		}
+	}
+
+	~ThreadPool()
+	{
+		{
+			auto lock = std::lock_guard{ _mutex };
+			_is_stopping = true;
+		}
+
+		_has_work.notify_all();
+	}
+
+	// The process-wide pool, created on first use.
+	static std::shared_ptr<ThreadPool> shared()
+	{
+		static auto pool = std::make_shared<ThreadPool>();
+		return pool;
+	}
+
+	Size_t size() const { return _threads.size(); }
+
+	template<typename Fn_T>
+	auto submit(Fn_T&& fn) -> std::future<std::invoke_result_t<std::decay_t<Fn_T>>>
+	{
+		using Result_t = std::invoke_result_t<std::decay_t<Fn_T>>;
+
+		auto task = std::make_shared<std::packaged_task<Result_t()>>(std::forward<Fn_T>(fn));
+		auto out = task->get_future();
+
+		{
+			auto lock = std::lock_guard{ _mutex };
+			if (_is_stopping) {
+				throw Exception("Cannot submit work to a thread pool that is shutting down");
+			}
+
+			_tasks.emplace([task]() { (*task)(); });
+		}
+
+		_has_work.notify_one();
+
+		return out;
+	}
+
+	// As above, but the task is abandoned with a CancelledException if the token is cancelled before it starts.
+	template<typename Fn_T>
+	auto submit(Fn_T&& fn, CancellationToken token) -> std::future<std::invoke_result_t<std::decay_t<Fn_T>>>
+	{
+		return submit([fn = std::forward<Fn_T>(fn), token = std::move(token)]() mutable {
+			token.throw_if_cancelled();
+			return fn();
+			});
+	}
+
+private:
+
+	void _run_worker()
+	{
+		while (true) {
+			auto task = std::function<void()>{};
+
+			{
+				auto lock = std::unique_lock{ _mutex };
+				_has_work.wait(lock, [this]() { return _is_stopping || !_tasks.empty(); });
+
+				if (_tasks.empty()) {
+					return;
+				}
+
+				task = std::move(_tasks.front());
+				_tasks.pop();
+			}
+
+			task();
+		}
+	}
+
+	std::mutex _mutex;
+	std::condition_variable _has_work;
+	std::queue<std::function<void()>> _tasks;
+	bool _is_stopping;
+
+	// Declared last so the threads are joined before the queue and its synchronisation are destroyed.
+	std::vector<std::jthread> _threads;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Splits [0, size) into at most one contiguous chunk per pool thread, each at least min_chunk_size long, and calls
+// fn(chunk_begin, chunk_end) for each on the pool. The results come back in chunk order. If a chunk throws, every chunk is
+// still waited for, since they may refer to the caller's data, before the first exception is rethrown.
+template<typename Fn_T>
+auto for_each_chunk(ThreadPool& pool, size_t size, size_t min_chunk_size, Fn_T fn) -> std::vector<std::invoke_result_t<Fn_T, size_t, size_t>>
+{
+	const auto chunk_count = std::max<size_t>(1, std::min(pool.size(), size / std::max<size_t>(min_chunk_size, 1)));
+	const auto chunk_size = (size + chunk_count - 1) / chunk_count;
+
+	auto futures = std::vector<std::future<std::invoke_result_t<Fn_T, size_t, size_t>>>{};
+	for (size_t chunk_begin = 0; chunk_begin < size; chunk_begin += chunk_size) {
+		futures.push_back(pool.submit([fn, chunk_begin, chunk_end = std::min(size, chunk_begin + chunk_size)]() {
+			return fn(chunk_begin, chunk_end);
+			}));
+	}
+
+	for (auto& future : futures) {
+		future.wait();
+	}
+
+	auto out = std::vector<std::invoke_result_t<Fn_T, size_t, size_t>>{};
+	out.reserve(futures.size());
+	for (auto& future : futures) {
+		out.push_back(future.get());
+	}
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Folds the transformed values of a random access range with an operation that is associative but not necessarily
+// commutative. Unlike std::reduce, which may reorder its operands, each chunk is folded left to right and the chunk results
+// are combined in order.
+template<typename Iter_T, typename Value_T, typename Combine_T, typename Transform_T>
+Value_T parallel_transform_reduce(ThreadPool& pool, Iter_T begin, Iter_T end, Value_T identity, Combine_T combine, Transform_T transform,
+	size_t min_chunk_size = 4096)
+{
+	const auto size = static_cast<size_t>(std::distance(begin, end));
+
+	const auto chunk_results = for_each_chunk(pool, size, min_chunk_size, [=](size_t chunk_begin, size_t chunk_end) {
+		auto out = identity;
+		for (auto it = begin + chunk_begin; it != begin + chunk_end; ++it) {
+			out = combine(out, transform(*it));
+		}
+
+		return out;
+		});
+
+	return std::accumulate(chunk_results.begin(), chunk_results.end(), identity, combine);
+}
+
+// Writes the running fold of the transformed values to out, so out[i] combines values 0 to i. The chunk totals are found
+// first, then each chunk is scanned again starting from the combined totals of the chunks before it.
+template<typename Iter_T, typename Out_T, typename Value_T, typename Combine_T, typename Transform_T>
+void parallel_transform_inclusive_scan(ThreadPool& pool, Iter_T begin, Iter_T end, Out_T out, Value_T identity, Combine_T combine,
+	Transform_T transform, size_t min_chunk_size = 4096)
+{
+	struct ChunkTotal
+	{
+		size_t begin;
+		size_t end;
+		Value_T total;
+	};
+
+	const auto size = static_cast<size_t>(std::distance(begin, end));
+
+	const auto chunk_totals = for_each_chunk(pool, size, min_chunk_size, [=](size_t chunk_begin, size_t chunk_end) {
+		auto total = identity;
+		for (auto it = begin + chunk_begin; it != begin + chunk_end; ++it) {
+			total = combine(total, transform(*it));
+		}
+
+		return ChunkTotal{ chunk_begin, chunk_end, total };
+		});
+
+	auto futures = std::vector<std::future<void>>{};
+	auto offset = identity;
+	for (const auto& [chunk_begin, chunk_end, total] : chunk_totals) {
+		futures.push_back(pool.submit([=]() {
+			auto running = offset;
+			for (auto idx = chunk_begin; idx != chunk_end; ++idx) {
+				running = combine(running, transform(*(begin + idx)));
+				*(out + idx) = running;
+			}
+			}));
+
+		offset = combine(offset, total);
+	}
+
+	for (auto& future : futures) {
+		future.wait();
+	}
+
+	for (auto& future : futures) {
+		future.get();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,134 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A ROWS x COLS grid held in a std::array, so it lives wherever its owner does and never touches the heap. Storage is
+// column-major, the same as arma::Mat, so iteration order and column access match the matrices it replaces.
+template<typename Value_T, size_t ROWS, size_t COLS = ROWS>
+class FixedGrid
+{
+	static_assert(ROWS > 0 && COLS > 0, "FixedGrid must have at least one row and one column");
+
+public:
+	using Value_t = Value_T;
+	using Size_t = size_t;
+	using This_t = FixedGrid<Value_t, ROWS, COLS>;
+
+private:
+	std::array<Value_t, ROWS * COLS> _values;
+
+public:
+	using Iterator_t = decltype(_values.begin());
+	using ConstIterator_t = decltype(_values.cbegin());
+
+	static constexpr Size_t n_rows = ROWS;
+	static constexpr Size_t n_cols = COLS;
+	static constexpr Size_t n_elem = ROWS * COLS;
+
+	constexpr FixedGrid()
+		: _values{}
+	{}
+
+	constexpr explicit FixedGrid(const Value_t& fill_value)
+		: _values{}
+	{
+		fill(fill_value);
+	}
+
+	constexpr FixedGrid(const FixedGrid&) = default;
+	constexpr FixedGrid& operator=(const FixedGrid&) = default;
+
+	constexpr FixedGrid(FixedGrid&&) = default;
+	constexpr FixedGrid& operator=(FixedGrid&&) = default;
+
+	template<typename Other_T>
+	static This_t from_matrix(const arma::Mat<Other_T>& mat)
+	{
+		if (mat.n_rows != ROWS || mat.n_cols != COLS) {
+			throw InvalidArgException(std::format("Cannot load a {}x{} matrix into a {}x{} grid", mat.n_rows, mat.n_cols, ROWS, COLS));
+		}
+
+		auto out = This_t{};
+		for (Size_t c = 0; c < COLS; ++c) {
+			for (Size_t r = 0; r < ROWS; ++r) {
+				out.at(r, c) = static_cast<Value_t>(mat.at(r, c));
+			}
+		}
+
+		return out;
+	}
+
+	arma::Mat<Value_t> as_matrix() const
+	{
+		auto out = arma::Mat<Value_t>(ROWS, COLS);
+		std::copy(_values.begin(), _values.end(), out.begin());
+
+		return out;
+	}
+
+	constexpr Value_t& at(Size_t row, Size_t col) { return _values[col * ROWS + row]; }
+	constexpr const Value_t& at(Size_t row, Size_t col) const { return _values[col * ROWS + row]; }
+
+	constexpr Value_t& operator()(Size_t row, Size_t col) { return at(row, col); }
+	constexpr const Value_t& operator()(Size_t row, Size_t col) const { return at(row, col); }
+
+	constexpr Value_t& operator[](Size_t idx) { return _values[idx]; }
+	constexpr const Value_t& operator[](Size_t idx) const { return _values[idx]; }
+
+	constexpr This_t& fill(const Value_t& value)
+	{
+		std::fill(_values.begin(), _values.end(), value);
+		return *this;
+	}
+
+	constexpr ConstIterator_t begin() const { return _values.cbegin(); }
+	constexpr Iterator_t begin() { return _values.begin(); }
+
+	constexpr ConstIterator_t end() const { return _values.cend(); }
+	constexpr Iterator_t end() { return _values.end(); }
+
+	constexpr std::span<Value_t, ROWS> col(Size_t c) { return std::span<Value_t, ROWS>{ _values.data() + c * ROWS, ROWS }; }
+	constexpr std::span<const Value_t, ROWS> col(Size_t c) const { return std::span<const Value_t, ROWS>{ _values.data() + c * ROWS, ROWS }; }
+
+	template<typename Fn_T>
+	constexpr void for_each_in_row(Size_t row, Fn_T&& fn) const
+	{
+		for (Size_t c = 0; c < COLS; ++c) {
+			fn(c, at(row, c));
+		}
+	}
+
+	template<typename Fn_T>
+	constexpr void for_each_in_col(Size_t col, Fn_T&& fn) const
+	{
+		for (Size_t r = 0; r < ROWS; ++r) {
+			fn(r, at(r, col));
+		}
+	}
+
+	// Calls fn(row, col) for every position in [row_begin, row_end) x [col_begin, col_end), in storage order.
+	template<typename Fn_T>
+	constexpr void for_each_position(Size_t row_begin, Size_t row_end, Size_t col_begin, Size_t col_end, Fn_T&& fn) const
+	{
+		for (auto c = col_begin; c < col_end; ++c) {
+			for (auto r = row_begin; r < row_end; ++r) {
+				fn(r, c);
+			}
+		}
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
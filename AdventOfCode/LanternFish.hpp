@@ -88,6 +88,18 @@ public:
 		throw Exception("Failed to read Lanternfish shoal from stream: Value out-of-range");
 	}
 
+	LanternfishShoal& load(std::span<const uint32_t> spawning_times)
+	{
+		_fish.clear();
+		_fish.reserve(spawning_times.size());
+
+		for (const auto time : spawning_times) {
+			_fish.emplace_back(time);
+		}
+
+		return *this;
+	}
+
 	Size_t size() const { return _fish.size(); }
 
 	Iterator_t begin() { return _fish.begin(); }
@@ -432,58 +432,132 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
-template<size_t ORIENTATION, typename Value_T>
-std::vector<Point2D<Value_T>> rasterize(const Line2d<Value_T>& line)
+// The lattice points of a horizontal, vertical or diagonal line, generated as they are read rather than stored. Points
+// run in order of increasing x, or of increasing y for vertical lines.
+template<typename Value_T>
+class LinePoints : public std::ranges::view_interface<LinePoints<Value_T>>
 {
-	auto out = std::vector<Point2D<Value_T>>{};
+public:
+	using Value_t = Value_T;
+	using Point_t = Point2D<Value_t>;
 
-	if constexpr (static_cast<bool>(ORIENTATION & Line2d<Value_T>::horizontal)) {
-		if (is_vertical(line)) {
-			const auto y_min = std::min(line.start.y, line.finish.y);
-			const auto y_max = std::max(line.start.y, line.finish.y);
+	class Iterator
+	{
+	public:
+		using iterator_concept = std::random_access_iterator_tag;
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Point_t;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() = default;
+
+		Iterator(Point_t first, int step_x, int step_y, difference_type idx)
+			: _first{ first }
+			, _step_x{ step_x }
+			, _step_y{ step_y }
+			, _idx{ idx }
+		{}
+
+		Point_t operator*() const { return (*this)[0]; }
+
+		Point_t operator[](difference_type offset) const
+		{
+			const auto idx = static_cast<int64_t>(_idx + offset);
+			return { static_cast<Value_t>(static_cast<int64_t>(_first.x) + idx * _step_x), static_cast<Value_t>(static_cast<int64_t>(_first.y) + idx * _step_y) };
+		}
 
-			auto out = std::vector<Point2D<Value_T>>{ y_max - y_min + 1 };
+		Iterator& operator++() { ++_idx; return *this; }
+		Iterator operator++(int) { auto out = *this; ++_idx; return out; }
+		Iterator& operator--() { --_idx; return *this; }
+		Iterator operator--(int) { auto out = *this; --_idx; return out; }
 
-			for (auto y = y_min; y <= y_max; ++y) {
-				out[y - y_min] = Point2D<Value_T>{ line.start.x, y };
-			}
+		Iterator& operator+=(difference_type offset) { _idx += offset; return *this; }
+		Iterator& operator-=(difference_type offset) { _idx -= offset; return *this; }
 
-			return out;
-		}
-	}
+		friend Iterator operator+(Iterator it, difference_type offset) { return it += offset; }
+		friend Iterator operator+(difference_type offset, Iterator it) { return it += offset; }
+		friend Iterator operator-(Iterator it, difference_type offset) { return it -= offset; }
+		friend difference_type operator-(const Iterator& left, const Iterator& right) { return left._idx - right._idx; }
 
-	if constexpr (static_cast<bool>(ORIENTATION & Line2d<Value_T>::vertical)) {
+		bool operator==(const Iterator& other) const { return _idx == other._idx; }
+		auto operator<=>(const Iterator& other) const { return _idx <=> other._idx; }
+
+	private:
+		Point_t _first;
+		int _step_x = 0;
+		int _step_y = 0;
+		difference_type _idx = 0;
+	};
+
+	LinePoints() = default;
+
+	LinePoints(Point_t first, int step_x, int step_y, size_t count)
+		: _first{ first }
+		, _step_x{ step_x }
+		, _step_y{ step_y }
+		, _count{ count }
+	{}
+
+	Iterator begin() const { return { _first, _step_x, _step_y, 0 }; }
+	Iterator end() const { return { _first, _step_x, _step_y, static_cast<std::ptrdiff_t>(_count) }; }
+
+	size_t size() const { return _count; }
+
+private:
+	Point_t _first;
+	int _step_x = 0;
+	int _step_y = 0;
+	size_t _count = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The points of the line as a LinePoints view. Lines whose orientation isn't in ORIENTATION throw, and the checks for the
+// orientations that aren't in it are compiled out.
+template<size_t ORIENTATION, typename Value_T>
+LinePoints<Value_T> rasterize_view(const Line2d<Value_T>& line)
+{
+	if constexpr (static_cast<bool>(ORIENTATION & Line2d<Value_T>::horizontal)) {
 		if (is_horizontal(line)) {
-			const auto x_min = std::min(line.start.x, line.finish.x);
-			const auto x_max = std::max(line.start.x, line.finish.x);
+			const auto& lower = line.start.x < line.finish.x ? line.start : line.finish;
+			const auto& upper = line.start.x < line.finish.x ? line.finish : line.start;
 
-			auto out = std::vector<Point2D<Value_T>>{ x_max - x_min + 1 };
+			return { lower, 1, 0, static_cast<size_t>(upper.x - lower.x) + 1 };
+		}
+	}
 
-			for (auto x = x_min; x <= x_max; ++x) {
-				out[x - x_min] = Point2D<Value_T>{ x, line.start.y };
-			}
+	if constexpr (static_cast<bool>(ORIENTATION & Line2d<Value_T>::vertical)) {
+		if (is_vertical(line)) {
+			const auto& lower = line.start.y < line.finish.y ? line.start : line.finish;
+			const auto& upper = line.start.y < line.finish.y ? line.finish : line.start;
 
-			return out;
+			return { lower, 0, 1, static_cast<size_t>(upper.y - lower.y) + 1 };
 		}
 	}
 
 	if constexpr (static_cast<bool>(ORIENTATION & Line2d<Value_T>::diagonal)) {
 		if (is_diagonal(line)) {
-			const auto [lower, upper] = line.start.x < line.finish.x ? std::make_pair(line.start, line.finish) : std::make_pair(line.finish, line.start);
-			const auto y_increment = lower.y < upper.y ? 1 : -1;
+			const auto& lower = line.start.x < line.finish.x ? line.start : line.finish;
+			const auto& upper = line.start.x < line.finish.x ? line.finish : line.start;
 
-			auto out = std::vector<Point2D<Value_T>>{ upper.x - lower.x + 1 };
-
-			for (auto point = lower; point.x <= upper.x; ++point.x, point.y += y_increment)
-			{
-				out[point.x - lower.x] = point;
-			}
-
-			return out;
+			return { lower, 1, lower.y < upper.y ? 1 : -1, static_cast<size_t>(upper.x - lower.x) + 1 };
 		}
 	}
 
-	throw Exception("Only horizontal or vertical lines can be rasterized");
+	throw Exception("Only horizontal, vertical or diagonal lines can be rasterized");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<size_t ORIENTATION, typename Value_T>
+std::vector<Point2D<Value_T>> rasterize(const Line2d<Value_T>& line)
+{
+	const auto points = rasterize_view<ORIENTATION>(line);
+
+	auto out = std::vector<Point2D<Value_T>>(points.size());
+	std::ranges::copy(points, out.begin());
+
+	return out;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
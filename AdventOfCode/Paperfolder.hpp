@@ -6,6 +6,7 @@
 #include <Maths/Geometry.hpp>
 
 #include "CharacterMaps.hpp"
+#include "BitGrid.hpp"
 
 #include <variant>
 
@@ -95,6 +96,15 @@ public:
 			});
 	}
 
+	BitGrid as_bit_grid() const
+	{
+		const auto dimensions = _get_dimensions();
+		return std::accumulate(_marks.begin(), _marks.end(), BitGrid(dimensions.y, dimensions.x), [](auto grid, auto point) {
+				grid.set(point.y, point.x);
+				return std::move(grid);
+			});
+	}
+
 private:
 
 	Point_t _get_dimensions() const {
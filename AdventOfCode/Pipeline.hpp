@@ -0,0 +1,380 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A fixed-capacity multi-producer/multi-consumer queue. Producers block while the queue is full, which is what gives a
+// pipeline its back-pressure. Once closed, pushes are refused and pops drain whatever is left before returning nothing.
+template<typename Value_T>
+class BoundedQueue : boost::noncopyable
+{
+public:
+	using Value_t = Value_T;
+	using Size_t = size_t;
+
+	explicit BoundedQueue(Size_t capacity)
+		: _capacity{ std::max(capacity, Size_t{ 1 }) }
+		, _is_closed{ false }
+	{}
+
+	bool push(Value_t value)
+	{
+		auto lock = std::unique_lock{ _mutex };
+		_not_full.wait(lock, [this]() { return _is_closed || _values.size() < _capacity; });
+
+		if (_is_closed) {
+			return false;
+		}
+
+		_values.push(std::move(value));
+		lock.unlock();
+
+		_not_empty.notify_one();
+
+		return true;
+	}
+
+	std::optional<Value_t> pop()
+	{
+		auto lock = std::unique_lock{ _mutex };
+		_not_empty.wait(lock, [this]() { return _is_closed || !_values.empty(); });
+
+		if (_values.empty()) {
+			return std::nullopt;
+		}
+
+		auto out = std::optional<Value_t>{ std::move(_values.front()) };
+		_values.pop();
+		lock.unlock();
+
+		_not_full.notify_one();
+
+		return out;
+	}
+
+	void close()
+	{
+		{
+			auto lock = std::lock_guard{ _mutex };
+			_is_closed = true;
+		}
+
+		_not_full.notify_all();
+		_not_empty.notify_all();
+	}
+
+	Size_t capacity() const { return _capacity; }
+
+private:
+	const Size_t _capacity;
+	bool _is_closed;
+	std::queue<Value_t> _values;
+
+	std::mutex _mutex;
+	std::condition_variable _not_full;
+	std::condition_variable _not_empty;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Latency of the work done by one pipeline stage, excluding the time its workers spend waiting on the queues.
+struct StageStats
+{
+	using Duration_t = std::chrono::nanoseconds;
+
+	size_t count{ 0 };
+	Duration_t total{ Duration_t::zero() };
+	Duration_t min{ Duration_t::max() };
+	Duration_t max{ Duration_t::zero() };
+
+	StageStats& add(Duration_t latency)
+	{
+		++count;
+		total += latency;
+		min = std::min(min, latency);
+		max = std::max(max, latency);
+
+		return *this;
+	}
+
+	StageStats& merge(const StageStats& other)
+	{
+		count += other.count;
+		total += other.total;
+		min = std::min(min, other.min);
+		max = std::max(max, other.max);
+
+		return *this;
+	}
+
+	Duration_t mean() const
+	{
+		return count == 0 ? Duration_t::zero() : total / static_cast<Duration_t::rep>(count);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Runs a batch of inputs through read -> parse -> solve, with each stage on its own pool of worker threads and bounded
+// queues between them. While one input is being solved the next can already be read and parsed. Results are returned in
+// input order. If any stage throws, the batch is abandoned and the first exception is rethrown from run().
+template<typename Input_T, typename Loaded_T, typename Parsed_T, typename Result_T>
+class Pipeline : boost::noncopyable
+{
+public:
+	using Input_t = Input_T;
+	using Loaded_t = Loaded_T;
+	using Parsed_t = Parsed_T;
+	using Result_t = Result_T;
+	using Size_t = size_t;
+
+	using Read_t = std::function<Loaded_t(const Input_t&)>;
+	using Parse_t = std::function<Parsed_t(Loaded_t)>;
+	using Solve_t = std::function<Result_t(Parsed_t)>;
+
+	enum class Stage
+	{
+		read,
+		parse,
+		solve
+	};
+
+	Pipeline(Read_t read, Parse_t parse, Solve_t solve)
+		: _read{ std::move(read) }
+		, _parse{ std::move(parse) }
+		, _solve{ std::move(solve) }
+		, _workers{ 1, 1, 1 }
+		, _queue_capacity{ 4 }
+	{}
+
+	Pipeline& workers(Stage stage, Size_t count)
+	{
+		if (count == 0) {
+			throw InvalidArgException("A pipeline stage needs at least one worker");
+		}
+
+		_workers[_stage_idx(stage)] = count;
+
+		return *this;
+	}
+
+	Pipeline& queue_capacity(Size_t capacity)
+	{
+		if (capacity == 0) {
+			throw InvalidArgException("Pipeline queues need a capacity of at least one");
+		}
+
+		_queue_capacity = capacity;
+
+		return *this;
+	}
+
+	Size_t workers(Stage stage) const { return _workers[_stage_idx(stage)]; }
+	Size_t queue_capacity() const { return _queue_capacity; }
+
+	// Statistics for the most recent call to run().
+	const StageStats& stats(Stage stage) const { return _stats[_stage_idx(stage)]; }
+
+	std::vector<Result_t> run(const std::vector<Input_t>& inputs)
+	{
+		auto batch = Batch{ inputs, _queue_capacity };
+		_stats.fill(StageStats{});
+
+		{
+			// Declared before the threads, so they outlive the workers that count them down.
+			auto readers_left = std::atomic<Size_t>{ _workers[0] };
+			auto parsers_left = std::atomic<Size_t>{ _workers[1] };
+
+			auto threads = std::vector<std::jthread>{};
+			threads.reserve(_workers[0] + _workers[1] + _workers[2]);
+
+			try {
+				for (Size_t i = 0; i < _workers[0]; ++i) {
+					threads.emplace_back([this, &batch, &readers_left]() {
+						_run_reader(batch);
+						if (--readers_left == 0) {
+							batch.loaded.close();
+						}
+						});
+				}
+
+				for (Size_t i = 0; i < _workers[1]; ++i) {
+					threads.emplace_back([this, &batch, &parsers_left]() {
+						_run_stage(batch, batch.loaded, Stage::parse, _parse, [&batch](Size_t idx, Parsed_t&& parsed) {
+							return batch.parsed.push({ idx, std::move(parsed) });
+							});
+
+						if (--parsers_left == 0) {
+							batch.parsed.close();
+						}
+						});
+				}
+
+				for (Size_t i = 0; i < _workers[2]; ++i) {
+					threads.emplace_back([this, &batch]() {
+						_run_stage(batch, batch.parsed, Stage::solve, _solve, [&batch](Size_t idx, Result_t&& result) {
+							batch.results[idx] = std::move(result);
+							return true;
+							});
+						});
+				}
+			}
+			catch (...) {
+				// A worker that couldn't be started would never count down, so stop the rest rather than wait on them.
+				_fail(batch, std::current_exception());
+			}
+		}
+
+		if (batch.error) {
+			std::rethrow_exception(batch.error);
+		}
+
+		auto out = make_vector<Result_t>(Capacity{ inputs.size() });
+		std::transform(batch.results.begin(), batch.results.end(), std::back_inserter(out), [](auto& result) {
+			return std::move(*result);
+			});
+
+		return out;
+	}
+
+private:
+
+	template<typename Value_T>
+	struct Item
+	{
+		Size_t idx;
+		Value_T value;
+	};
+
+	struct Batch
+	{
+		Batch(const std::vector<Input_t>& inputs_, Size_t capacity)
+			: inputs{ inputs_ }
+			, next_input{ 0 }
+			, is_cancelled{ false }
+			, loaded{ capacity }
+			, parsed{ capacity }
+			, results(inputs_.size())
+		{}
+
+		const std::vector<Input_t>& inputs;
+		std::atomic<Size_t> next_input;
+		std::atomic<bool> is_cancelled;
+
+		BoundedQueue<Item<Loaded_t>> loaded;
+		BoundedQueue<Item<Parsed_t>> parsed;
+		std::vector<std::optional<Result_t>> results;
+
+		std::mutex error_mutex;
+		std::exception_ptr error;
+	};
+
+	static constexpr Size_t _stage_idx(Stage stage) { return static_cast<Size_t>(stage); }
+
+	template<typename Fn_T>
+	static auto _timed(StageStats& stats, Fn_T&& fn)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		auto out = fn();
+		stats.add(std::chrono::duration_cast<StageStats::Duration_t>(std::chrono::steady_clock::now() - start));
+
+		return out;
+	}
+
+	void _fail(Batch& batch, std::exception_ptr error)
+	{
+		{
+			auto lock = std::lock_guard{ batch.error_mutex };
+			if (!batch.error) {
+				batch.error = std::move(error);
+			}
+		}
+
+		batch.is_cancelled = true;
+
+		batch.loaded.close();
+		batch.parsed.close();
+	}
+
+	void _record(Stage stage, const StageStats& stats)
+	{
+		auto lock = std::lock_guard{ _stats_mutex };
+		_stats[_stage_idx(stage)].merge(stats);
+	}
+
+	void _run_reader(Batch& batch)
+	{
+		auto stats = StageStats{};
+
+		try {
+			for (auto idx = batch.next_input++; idx < batch.inputs.size() && !batch.is_cancelled; idx = batch.next_input++) {
+				auto loaded = _timed(stats, [this, &batch, idx]() { return _read(batch.inputs[idx]); });
+				if (!batch.loaded.push({ idx, std::move(loaded) })) {
+					break;
+				}
+			}
+		}
+		catch (...) {
+			_fail(batch, std::current_exception());
+		}
+
+		_record(Stage::read, stats);
+	}
+
+	// Applies work to each item until the input queue is drained and hands the output to emit, which returns false to stop
+	// early. Only the work itself is timed.
+	template<typename Value_T, typename Work_T, typename Emit_T>
+	void _run_stage(Batch& batch, BoundedQueue<Item<Value_T>>& input, Stage stage, Work_T& work, Emit_T&& emit)
+	{
+		auto stats = StageStats{};
+
+		try {
+			while (auto item = input.pop()) {
+				if (batch.is_cancelled) {
+					break;
+				}
+
+				auto output = _timed(stats, [&work, &item]() { return work(std::move(item->value)); });
+				if (!emit(item->idx, std::move(output))) {
+					break;
+				}
+			}
+		}
+		catch (...) {
+			_fail(batch, std::current_exception());
+		}
+
+		_record(stage, stats);
+	}
+
+	Read_t _read;
+	Parse_t _parse;
+	Solve_t _solve;
+
+	std::array<Size_t, 3> _workers;
+	Size_t _queue_capacity;
+
+	std::mutex _stats_mutex;
+	std::array<StageStats, 3> _stats;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
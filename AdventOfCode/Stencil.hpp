@@ -0,0 +1,315 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+namespace stencil
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+using Size_t = size_t;
+
+struct Offset
+{
+	std::ptrdiff_t row;
+	std::ptrdiff_t col;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Up, down, left and right, at the given distance from the centre cell.
+template<Size_t DISTANCE = 1>
+struct FourConnected
+{
+	static constexpr Size_t radius = DISTANCE;
+
+	static constexpr auto offsets = []() {
+		constexpr auto d = static_cast<std::ptrdiff_t>(DISTANCE);
+		return std::array<Offset, 4>{ { {-d, 0}, {d, 0}, {0, -d}, {0, d} } };
+	}();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The four connected cells plus the four diagonals, at the given distance from the centre cell.
+template<Size_t DISTANCE = 1>
+struct EightConnected
+{
+	static constexpr Size_t radius = DISTANCE;
+
+	static constexpr auto offsets = []() {
+		constexpr auto d = static_cast<std::ptrdiff_t>(DISTANCE);
+		return std::array<Offset, 8>{ { {-d, 0}, {d, 0}, {0, -d}, {0, d}, {-d, -d}, {-d, d}, {d, -d}, {d, d} } };
+	}();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Every cell of the (2 * RADIUS + 1)^2 window, except the centre cell.
+template<Size_t RADIUS>
+struct Window
+{
+	static constexpr Size_t radius = RADIUS;
+
+	static constexpr auto offsets = []() {
+		constexpr auto r = static_cast<std::ptrdiff_t>(RADIUS);
+
+		auto out = std::array<Offset, (2 * RADIUS + 1) * (2 * RADIUS + 1) - 1>{};
+		auto it = out.begin();
+		for (auto dc = -r; dc <= r; ++dc) {
+			for (auto dr = -r; dr <= r; ++dr) {
+				if (dr != 0 || dc != 0) {
+					*it++ = Offset{ dr, dc };
+				}
+			}
+		}
+
+		return out;
+	}();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The neighbours of a single cell. BOUNDED neighbourhoods skip any neighbour that lies outside the grid; unbounded ones don't
+// check at all, so they must only be used where the whole stencil is known to fit.
+template<typename Stencil_T, bool BOUNDED>
+class Neighbours
+{
+	static constexpr auto _size = Stencil_T::offsets.size();
+
+public:
+
+	Neighbours(Size_t row, Size_t col, Size_t rows, Size_t cols)
+		: _row{ row }
+		, _col{ col }
+		, _rows{ rows }
+		, _cols{ cols }
+	{}
+
+	static constexpr bool is_bounded() { return BOUNDED; }
+
+	template<typename Fn_T>
+	void operator()(Fn_T&& fn) const
+	{
+		_for_each(fn, std::make_index_sequence<_size>{});
+	}
+
+	template<typename Pred_T>
+	bool all_of(Pred_T&& pred) const
+	{
+		return _all_of(pred, std::make_index_sequence<_size>{});
+	}
+
+	template<typename Pred_T>
+	bool any_of(Pred_T&& pred) const
+	{
+		return !all_of([&pred](auto r, auto c) { return !pred(r, c); });
+	}
+
+private:
+
+	template<Size_t IDX>
+	bool _is_in_grid() const
+	{
+		if constexpr (BOUNDED) {
+			constexpr auto offset = Stencil_T::offsets[IDX];
+			const auto r = static_cast<std::ptrdiff_t>(_row) + offset.row;
+			const auto c = static_cast<std::ptrdiff_t>(_col) + offset.col;
+
+			return r >= 0 && c >= 0 && r < static_cast<std::ptrdiff_t>(_rows) && c < static_cast<std::ptrdiff_t>(_cols);
+		}
+		else {
+			return true;
+		}
+	}
+
+	template<Size_t IDX, typename Fn_T>
+	auto _apply(Fn_T& fn) const
+	{
+		constexpr auto offset = Stencil_T::offsets[IDX];
+		return fn(_row + offset.row, _col + offset.col);
+	}
+
+	template<typename Fn_T, Size_t... IDX>
+	void _for_each(Fn_T& fn, std::index_sequence<IDX...>) const
+	{
+		((_is_in_grid<IDX>() ? (_apply<IDX>(fn), void()) : void()), ...);
+	}
+
+	template<typename Pred_T, Size_t... IDX>
+	bool _all_of(Pred_T& pred, std::index_sequence<IDX...>) const
+	{
+		return ((!_is_in_grid<IDX>() || _apply<IDX>(pred)) && ...);
+	}
+
+	Size_t _row;
+	Size_t _col;
+	Size_t _rows;
+	Size_t _cols;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Calls fn(row, col, neighbours) for every cell of a rows x cols grid, in column-major order. Cells whose whole stencil fits
+// in the grid get an unbounded neighbourhood, so the interior loop carries no bounds checks; only the border cells pay for them.
+template<typename Stencil_T, typename Fn_T>
+void for_each_cell(Size_t rows, Size_t cols, Fn_T&& fn)
+{
+	constexpr auto radius = Stencil_T::radius;
+
+	auto border_cell = [&fn, rows, cols](Size_t r, Size_t c) {
+		fn(r, c, Neighbours<Stencil_T, true>{ r, c, rows, cols });
+	};
+
+	if (rows <= 2 * radius || cols <= 2 * radius) {
+		for (Size_t c = 0; c < cols; ++c) {
+			for (Size_t r = 0; r < rows; ++r) {
+				border_cell(r, c);
+			}
+		}
+
+		return;
+	}
+
+	for (Size_t c = 0; c < cols; ++c) {
+		if (c < radius || c >= cols - radius) {
+			for (Size_t r = 0; r < rows; ++r) {
+				border_cell(r, c);
+			}
+
+			continue;
+		}
+
+		for (Size_t r = 0; r < radius; ++r) {
+			border_cell(r, c);
+		}
+
+		for (Size_t r = radius; r < rows - radius; ++r) {
+			fn(r, c, Neighbours<Stencil_T, false>{ r, c, rows, cols });
+		}
+
+		for (Size_t r = rows - radius; r < rows; ++r) {
+			border_cell(r, c);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// True for grids that can enumerate a rectangular region of positions in their own storage order (e.g. TiledGrid).
+template<typename Grid_T>
+constexpr bool has_region_walk = requires (const Grid_T& grid) {
+	grid.for_each_position(Size_t{}, Size_t{}, Size_t{}, Size_t{}, [](Size_t, Size_t) {});
+};
+
+// As above, but for any grid with n_rows and n_cols. Grids that can walk a region in storage order are visited interior first
+// and then border strip by border strip; all others fall back to the column-major walk.
+template<typename Stencil_T, typename Grid_T, typename Fn_T>
+void for_each_cell(const Grid_T& grid, Fn_T&& fn)
+{
+	const auto rows = static_cast<Size_t>(grid.n_rows);
+	const auto cols = static_cast<Size_t>(grid.n_cols);
+
+	if constexpr (has_region_walk<Grid_T>) {
+		constexpr auto radius = Stencil_T::radius;
+
+		auto border_cell = [&fn, rows, cols](Size_t r, Size_t c) {
+			fn(r, c, Neighbours<Stencil_T, true>{ r, c, rows, cols });
+		};
+
+		if (rows <= 2 * radius || cols <= 2 * radius) {
+			grid.for_each_position(0, rows, 0, cols, border_cell);
+			return;
+		}
+
+		grid.for_each_position(radius, rows - radius, radius, cols - radius, [&fn, rows, cols](Size_t r, Size_t c) {
+			fn(r, c, Neighbours<Stencil_T, false>{ r, c, rows, cols });
+			});
+
+		grid.for_each_position(0, radius, 0, cols, border_cell);
+		grid.for_each_position(rows - radius, rows, 0, cols, border_cell);
+		grid.for_each_position(radius, rows - radius, 0, radius, border_cell);
+		grid.for_each_position(radius, rows - radius, cols - radius, cols, border_cell);
+	}
+	else {
+		for_each_cell<Stencil_T>(rows, cols, std::forward<Fn_T>(fn));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A grid padded on every side by the stencil radius. Filling the padding with a suitable sentinel lets every real cell be
+// processed with an unbounded neighbourhood.
+template<typename Stencil_T>
+struct Halo
+{
+	static constexpr Size_t width = Stencil_T::radius;
+
+	template<typename Value_T>
+	static arma::Mat<Value_T> make(Size_t rows, Size_t cols, Value_T fill_value)
+	{
+		auto out = arma::Mat<Value_T>(rows + 2 * width, cols + 2 * width);
+		out.fill(fill_value);
+
+		return out;
+	}
+
+	template<typename Grid_T, typename Value_T>
+	static Grid_T make_as(Size_t rows, Size_t cols, Value_T fill_value)
+	{
+		auto out = Grid_T(rows + 2 * width, cols + 2 * width);
+		out.fill(fill_value);
+
+		return out;
+	}
+
+	// Calls fn(row, col, neighbours) for every non-padding cell of a padded grid, in column-major order. The row and column
+	// are in padded coordinates.
+	template<typename Fn_T>
+	static void for_each_cell(Size_t padded_rows, Size_t padded_cols, Fn_T&& fn)
+	{
+		if (padded_rows <= 2 * width || padded_cols <= 2 * width) {
+			return;
+		}
+
+		for (auto c = width; c < padded_cols - width; ++c) {
+			for (auto r = width; r < padded_rows - width; ++r) {
+				fn(r, c, Neighbours<Stencil_T, false>{ r, c, padded_rows, padded_cols });
+			}
+		}
+	}
+
+	// As above, walking the grid in its own storage order where it supports that.
+	template<typename Grid_T, typename Fn_T>
+	static void for_each_cell(const Grid_T& padded, Fn_T&& fn)
+	{
+		const auto padded_rows = static_cast<Size_t>(padded.n_rows);
+		const auto padded_cols = static_cast<Size_t>(padded.n_cols);
+
+		if constexpr (has_region_walk<Grid_T>) {
+			if (padded_rows <= 2 * width || padded_cols <= 2 * width) {
+				return;
+			}
+
+			padded.for_each_position(width, padded_rows - width, width, padded_cols - width, [&fn, padded_rows, padded_cols](Size_t r, Size_t c) {
+				fn(r, c, Neighbours<Stencil_T, false>{ r, c, padded_rows, padded_cols });
+				});
+		}
+		else {
+			for_each_cell(padded_rows, padded_cols, std::forward<Fn_T>(fn));
+		}
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: stencil
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -45,6 +45,11 @@ public:
 		Assert::AreEqual(aoc::bingo::Board::Id_t{ 10 }, aoc::bingo::Board{ 10, 3 }.id());
 	}
 
+	TEST_METHOD(BoardLargerThanMaxSizeThrows)
+	{
+		Assert::ExpectException<aoc::InvalidArgException>([]() { aoc::bingo::Board{ 0, aoc::bingo::Board::max_size + 1 }; });
+	}
+
 	TEST_METHOD(LoadBoard)
 	{
 		constexpr auto board_str =
@@ -164,6 +169,27 @@ public:
 		Assert::AreEqual(aoc::bingo::Board::State_t::win, player.play_number(17));
 	}
 
+	TEST_METHOD(BoardWinsAsSoonAsAColumnIsMarked)
+	{
+		constexpr auto board_str =
+			"22 13 17\n"
+			" 8  2 23\n"
+			"21  9 14";
+
+		std::stringstream ss{ board_str };
+
+		auto board = aoc::bingo::Board{ 0, 3 }.load(ss);
+
+		Assert::IsFalse(board.mark(99));
+		Assert::IsTrue(board.mark(2));
+		Assert::IsTrue(board.mark(2));
+		Assert::IsTrue(board.mark(13));
+		Assert::AreEqual(aoc::bingo::Board::State_t::no_win, board.state());
+
+		Assert::IsTrue(board.mark(9));
+		Assert::AreEqual(aoc::bingo::Board::State_t::win, board.state());
+	}
+
 	TEST_METHOD(GameDetectsRowWin)
 	{
 
@@ -1,9 +1,10 @@
-#include "CppUnitTest.h"
+﻿#include "CppUnitTest.h"
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 #include "Common.hpp"
 #include <Maths/Geometry.hpp>
 #include "DiagnosticLog.hpp"
+#include "TiledGrid.hpp"
 #include "BoatSystems.hpp"
 #include "AdventOfCode.hpp"
 
@@ -313,6 +314,114 @@ public:
 		Assert::AreEqual(15, net_aim.x);
 		Assert::AreEqual(60, net_aim.y);
 	}
+
+	TEST_METHOD(AimingCompositionIsAssociative)
+	{
+		const auto a = aoc::Aiming::from({ 5, 0 });
+		const auto b = aoc::Aiming::from({ 0, 5 });
+		const auto c = aoc::Aiming::from({ 8, 0 });
+
+		const auto left = (a + b) + c;
+		const auto right = a + (b + c);
+
+		Assert::AreEqual(left.x, right.x);
+		Assert::AreEqual(left.aim, right.aim);
+		Assert::AreEqual(left.depth, right.depth);
+
+		// Composing the steps gives the same as applying the commands in turn.
+		const auto applied = aoc::Aiming{} + aoc::Direction{ 5, 0 } + aoc::Direction{ 0, 5 } + aoc::Direction{ 8, 0 };
+		Assert::AreEqual(applied.depth, left.depth);
+	}
+
+	TEST_METHOD(ParallelCourseMatchesSequentialCourse)
+	{
+		auto generator = std::mt19937{ 2468 };
+		auto command = std::uniform_int_distribution<int>{ 0, 2 };
+		auto magnitude = std::uniform_int_distribution<int>{ 1, 9 };
+
+		auto commands = std::vector<aoc::Direction>(20000);
+		std::generate(commands.begin(), commands.end(), [&]() {
+			const auto m = magnitude(generator);
+			switch (command(generator)) {
+			case 0: return aoc::Direction{ m, 0 };
+			case 1: return aoc::Direction{ 0, m };
+			default: return aoc::Direction{ 0, -m };
+			}
+			});
+
+		const auto& boat_systems = aoc::Submarine().boat_systems();
+		auto pool = aoc::ThreadPool{ 4 };
+
+		Assert::IsTrue(boat_systems.net_direction(commands.begin(), commands.end()) == boat_systems.net_direction(commands.begin(), commands.end(), pool));
+		Assert::IsTrue(boat_systems.net_aiming(commands.begin(), commands.end()) == boat_systems.net_aiming(commands.begin(), commands.end(), pool));
+
+		Assert::IsTrue(boat_systems.track_course(commands.begin(), commands.end()) == boat_systems.track_course(commands.begin(), commands.end(), pool));
+
+		const auto aimed_course = boat_systems.track_aimed_course(commands.begin(), commands.end(), pool);
+		Assert::IsTrue(boat_systems.track_aimed_course(commands.begin(), commands.end()) == aimed_course);
+		Assert::IsTrue(boat_systems.net_aiming(commands.begin(), commands.end()) == aimed_course.back());
+	}
+
+	TEST_METHOD(AimedCourseOnExampleData)
+	{
+		const auto commands = std::vector<aoc::Direction>{ { 5, 0 }, { 0, 5 }, { 8, 0 }, { 0, -3 }, { 0, 8 }, { 2, 0 } };
+
+		auto pool = aoc::ThreadPool{ 2 };
+		const auto course = aoc::Submarine().boat_systems().track_aimed_course(commands.begin(), commands.end(), pool);
+
+		Assert::AreEqual(size_t{ 6 }, course.size());
+		Assert::AreEqual(13, course[2].x);
+		Assert::AreEqual(40, course[2].y);
+		Assert::AreEqual(15, course.back().x);
+		Assert::AreEqual(60, course.back().y);
+	}
+
+	TEST_METHOD(CourseCommandsAreTokenizedIntoArrays)
+	{
+		const auto course = aoc::CourseCommands{ "forward 5\r\ndown 5\r\nforward 8\r\nup 3\r\ndown 8\r\nforward 2\r\n" };
+
+		Assert::AreEqual(size_t{ 6 }, course.size());
+		Assert::IsTrue(std::vector<int>{ 5, 0, 8, 0, 0, 2 } == std::vector<int>(course.x().begin(), course.x().end()));
+		Assert::IsTrue(std::vector<int>{ 0, 5, 0, -3, 8, 0 } == std::vector<int>(course.depth().begin(), course.depth().end()));
+
+		const auto& boat_systems = aoc::Submarine().boat_systems();
+		Assert::IsTrue(aoc::Direction{ 15, 10 } == boat_systems.net_direction(course));
+		Assert::IsTrue(aoc::Direction{ 15, 60 } == boat_systems.net_aiming(course));
+	}
+
+	TEST_METHOD(CourseTokenizerMatchesStreamExtraction)
+	{
+		constexpr auto commands = "forward 3\ndown 3\nforward 12\ndown 5\nup 2\nforward 7\nup 11\nforward 1";
+
+		auto ss = std::stringstream{ commands };
+		const auto course = aoc::CourseCommands{ ss };
+
+		ss = std::stringstream{ commands };
+		using StreamIter_t = std::istream_iterator<aoc::Direction>;
+		const auto extracted = std::vector<aoc::Direction>(StreamIter_t{ ss }, StreamIter_t{});
+
+		Assert::AreEqual(extracted.size(), course.size());
+		for (size_t i = 0; i < extracted.size(); ++i) {
+			Assert::IsTrue(extracted[i] == course[i]);
+		}
+	}
+
+	TEST_METHOD(InvalidCourseCommandReportsItsLine)
+	{
+		auto course = aoc::CourseCommands{};
+
+		for (const auto& [text, line] : { std::pair{ "forward 3\nbackward 3", 2 }, std::pair{ "forward 3\n\ndown x", 3 }, std::pair{ "fwd 1", 1 }, std::pair{ "up 1\nup   ", 2 } }) {
+			try {
+				course.load(text);
+				Assert::Fail();
+			}
+			catch (const aoc::ParseException& e) {
+				Assert::AreEqual(size_t(line), e.line_number);
+			}
+
+			Assert::AreEqual(size_t{ 0 }, course.size());
+		}
+	}
 };
 
 TEST_CLASS(DepthMeasurements)
@@ -325,7 +434,7 @@ public:
 
 		auto depth_score = aoc::Submarine().boat_systems().depth_score<1>(measurements.begin(), measurements.end());
 
-		Assert::AreEqual(uint32_t{ 4 }, depth_score);
+		Assert::AreEqual(uint64_t{ 4 }, depth_score);
 	}
 
 	TEST_METHOD(DepthScoreVectorWithVariousJumps)
@@ -334,7 +443,7 @@ public:
 
 		auto depth_score = aoc::Submarine().boat_systems().depth_score<1>(measurements.begin(), measurements.end());
 
-		Assert::AreEqual(uint32_t{ 6 }, depth_score);
+		Assert::AreEqual(uint64_t{ 6 }, depth_score);
 	}
 
 	TEST_METHOD(ExampleValues)
@@ -343,7 +452,83 @@ public:
 
 		auto depth_score = aoc::Submarine().boat_systems().depth_score<1>(measurements.begin(), measurements.end());
 
-		Assert::AreEqual(uint32_t{ 7 }, depth_score);
+		Assert::AreEqual(uint64_t{ 7 }, depth_score);
+	}
+
+	TEST_METHOD(SpanScoreMatchesIteratorScore)
+	{
+		auto generator = std::mt19937{ 12345 };
+		auto distribution = std::uniform_int_distribution<uint32_t>{ 0, 10000 };
+
+		// More values than one counting block, also written out to be read back through stream iterators for the generic path.
+		auto measurements = std::vector<uint32_t>(70000);
+		std::generate(measurements.begin(), measurements.end(), [&]() { return distribution(generator); });
+
+		auto text = std::stringstream{};
+		std::copy(measurements.begin(), measurements.end(), std::ostream_iterator<uint32_t>(text, "\n"));
+
+		using Iter_t = std::istream_iterator<uint32_t>;
+		const auto& boat_systems = aoc::Submarine().boat_systems();
+
+		auto stream_1 = std::stringstream{ text.str() };
+		Assert::AreEqual(boat_systems.depth_score<1>(Iter_t{ stream_1 }, Iter_t{}),
+			boat_systems.depth_score<1>(std::span{ measurements }));
+
+		auto stream_3 = std::stringstream{ text.str() };
+		Assert::AreEqual(boat_systems.depth_score<3>(Iter_t{ stream_3 }, Iter_t{}),
+			boat_systems.depth_score<3>(std::span{ measurements }));
+	}
+
+	TEST_METHOD(SpanScoreOfTooFewValuesIsZero)
+	{
+		const auto measurements = std::array<uint32_t, 3>{ 1, 2, 3 };
+
+		Assert::AreEqual(uint64_t{ 0 }, aoc::Submarine().boat_systems().depth_score<3>(std::span{ measurements }));
+		Assert::AreEqual(uint64_t{ 0 }, aoc::Submarine().boat_systems().depth_score<1>(std::span<const uint32_t>{}));
+	}
+
+	TEST_METHOD(MultipleWindowsInOnePass)
+	{
+		auto generator = std::mt19937{ 67890 };
+		auto distribution = std::uniform_int_distribution<uint32_t>{ 0, 10000 };
+
+		auto measurements = std::vector<uint32_t>(50000);
+		std::generate(measurements.begin(), measurements.end(), [&]() { return distribution(generator); });
+
+		const auto& boat_systems = aoc::Submarine().boat_systems();
+		const auto window_sizes = std::vector<size_t>{ 1, 3, 7, 100 };
+		const auto expected = std::vector<uint64_t>{
+			boat_systems.depth_score<1>(std::span{ measurements }),
+			boat_systems.depth_score<3>(std::span{ measurements }),
+			boat_systems.depth_score<7>(std::span{ measurements }),
+			boat_systems.depth_score<100>(std::span{ measurements })
+		};
+
+		Assert::IsTrue(expected == boat_systems.depth_scores(measurements.begin(), measurements.end(), window_sizes));
+
+		auto pool = aoc::ThreadPool{ 4 };
+		Assert::IsTrue(expected == boat_systems.depth_scores(std::span{ measurements }, window_sizes, pool));
+
+		auto text = std::stringstream{};
+		std::copy(measurements.begin(), measurements.end(), std::ostream_iterator<uint32_t>(text, "\n"));
+
+		using Iter_t = std::istream_iterator<uint32_t>;
+		const auto streamed = boat_systems.depth_scores<1, 3, 7, 100>(Iter_t{ text }, Iter_t{});
+		Assert::IsTrue(std::equal(expected.begin(), expected.end(), streamed.begin()));
+	}
+
+	TEST_METHOD(MultipleWindowsOnExampleValues)
+	{
+		const auto measurements = std::vector<uint32_t>{ 199, 200, 208, 210, 200, 207, 240, 269, 260, 263 };
+
+		const auto scores = aoc::Submarine().boat_systems().depth_scores<1, 3>(measurements.begin(), measurements.end());
+
+		Assert::AreEqual(uint64_t{ 7 }, scores[0]);
+		Assert::AreEqual(uint64_t{ 5 }, scores[1]);
+
+		Assert::ExpectException<aoc::InvalidArgException>([&measurements]() {
+			aoc::Submarine().boat_systems().depth_scores(measurements.begin(), measurements.end(), std::vector<size_t>{ 1, 0 });
+			});
 	}
 };
 
@@ -411,10 +596,40 @@ public:
 		const auto best_match = aoc::LifeSupport(log).filter_using_least_frequent_bits();
 		Assert::AreEqual(uint32_t{ 0b10100000000 }, best_match);
 	}
+
+	TEST_METHOD(RatingFollowsEntriesInsertedLater)
+	{
+		std::stringstream ss("00100\n11110\n10110\n10111\n10101\n01111");
+		auto life_support = aoc::LifeSupport(aoc::DiagnosticLog{ ss });
+
+		for (const auto& entry : { "00111", "11100", "10000", "11001", "00010", "01010" }) {
+			auto line = std::stringstream{ entry };
+			auto log_entry = aoc::DiagnosticLog::Entry_t{};
+			line >> log_entry;
+
+			life_support.insert(log_entry);
+		}
+
+		Assert::AreEqual(uint32_t{ 23 }, life_support.filter_using_most_frequent_bits());
+		Assert::AreEqual(uint32_t{ 10 }, life_support.filter_using_least_frequent_bits());
+		Assert::AreEqual(uint32_t{ 230 }, life_support.rating());
+	}
 };
 
 TEST_CLASS(VentAnalysis)
 {
+	static constexpr auto _example =
+		"0,9 -> 5,9\n"
+		"8,0 -> 0,8\n"
+		"9,4 -> 3,4\n"
+		"2,2 -> 2,1\n"
+		"7,0 -> 7,4\n"
+		"6,4 -> 2,0\n"
+		"0,9 -> 2,9\n"
+		"3,4 -> 1,4\n"
+		"0,0 -> 8,8\n"
+		"5,5 -> 8,2";
+
 public:
 	TEST_METHOD(VentAnalyserScoresExampleData)
 	{
@@ -453,6 +668,149 @@ public:
 		Assert::AreEqual(uint32_t{ 12 }, aoc::VentAnalyzer{ data }
 		.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>());
 	}
+
+	TEST_METHOD(DenseAndSparseBackendsAgree)
+	{
+		constexpr auto all_formations = aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal;
+
+		// A few short lines far apart, so the bounding box is much larger than the points covered.
+		constexpr auto data_str =
+			"0,9 -> 5,9\n"
+			"3,5 -> 3,12\n"
+			"0,0 -> 8,8\n"
+			"1000000,2000000 -> 1000010,2000000\n"
+			"1000005,1999995 -> 1000005,2000005\n"
+			"1000000,1999990 -> 1000020,2000010";
+
+		for (const auto backend : { aoc::VentAnalyzer::DensityBackend::automatic, aoc::VentAnalyzer::DensityBackend::sparse }) {
+			std::stringstream data{ data_str };
+			Assert::AreEqual(uint32_t{ 4 }, aoc::VentAnalyzer{ data }.score<all_formations>(backend));
+		}
+
+		constexpr auto example_str =
+			"0,9 -> 5,9\n"
+			"8,0 -> 0,8\n"
+			"9,4 -> 3,4\n"
+			"2,2 -> 2,1\n"
+			"7,0 -> 7,4\n"
+			"6,4 -> 2,0\n"
+			"0,9 -> 2,9\n"
+			"3,4 -> 1,4\n"
+			"0,0 -> 8,8\n"
+			"5,5 -> 8,2";
+
+		for (const auto backend : { aoc::VentAnalyzer::DensityBackend::dense, aoc::VentAnalyzer::DensityBackend::sparse, aoc::VentAnalyzer::DensityBackend::sweep }) {
+			std::stringstream data{ example_str };
+			Assert::AreEqual(uint32_t{ 12 }, aoc::VentAnalyzer{ data }.score<all_formations>(backend));
+		}
+	}
+
+	TEST_METHOD(TiledCountOnPoolMatchesSerialCount)
+	{
+		constexpr auto all_formations = aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal;
+
+		// Long lines in every direction, so most of them are clipped to several tiles.
+		auto data_str = std::string{};
+		for (auto i = 0; i < 300; ++i) {
+			data_str += std::format("{},{} -> {},{}\n", 0, 7 * i, 1900 - 3 * i, 7 * i);
+			data_str += std::format("{},{} -> {},{}\n", 11 * i, 1500, 11 * i, i);
+			data_str += std::format("{},{} -> {},{}\n", 5 * i, 0, 5 * i + 1000, 1000);
+			data_str += std::format("{},{} -> {},{}\n", 2000 - 4 * i, 3 * i, 2000 - 4 * i - 700, 3 * i + 700);
+		}
+		data_str.pop_back();
+
+		auto pool = aoc::ThreadPool{ 4 };
+
+		std::stringstream serial_data{ data_str };
+		std::stringstream pooled_data{ data_str };
+		const auto expected = aoc::VentAnalyzer{ serial_data }.score<all_formations>(aoc::VentAnalyzer::DensityBackend::dense);
+		Assert::AreEqual(expected, aoc::VentAnalyzer{ pooled_data }.score<all_formations>(pool));
+
+		std::stringstream straight_data{ data_str };
+		std::stringstream pooled_straight_data{ data_str };
+		Assert::AreEqual(aoc::VentAnalyzer{ straight_data }.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>(),
+			aoc::Submarine{}.boat_systems().detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>(pooled_straight_data, pool));
+	}
+
+	TEST_METHOD(FieldAnswersRegionQueries)
+	{
+		std::stringstream data{ _example };
+		const auto field = aoc::VentAnalyzer{ data }.field<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>();
+
+		using Region_t = aoc::VentField::Region_t;
+
+		Assert::AreEqual(size_t{ 12 }, field.overlaps());
+		Assert::AreEqual(size_t{ 12 }, field.overlaps_in(Region_t{ { 0, 100 }, { 100, 0 } }));
+		Assert::AreEqual(size_t{ 3 }, field.overlaps_in(Region_t{ { 0, 4 }, { 4, 0 } }));
+		Assert::AreEqual(size_t{ 0 }, field.overlaps_in(Region_t{ { 20, 30 }, { 30, 20 } }));
+
+		Assert::AreEqual(uint32_t{ 3 }, field.density({ 4, 4 }));
+		Assert::AreEqual(uint32_t{ 0 }, field.density({ 40, 4 }));
+
+		Assert::AreEqual(size_t{ 1 }, field.count_above(2, Region_t{ { 0, 4 }, { 4, 0 } }));
+		Assert::AreEqual(size_t{ 2 }, field.count_above(2, Region_t{ { 0, 9 }, { 9, 0 } }));
+	}
+
+	TEST_METHOD(FieldFindsTheHottestPoints)
+	{
+		std::stringstream data{ _example };
+		const auto field = aoc::VentAnalyzer{ data }.field<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>();
+
+		auto pool = aoc::ThreadPool{ 2 };
+
+		for (const auto& hottest : { field.hottest(3), field.hottest(3, pool) }) {
+			Assert::AreEqual(size_t{ 3 }, hottest.size());
+			Assert::IsTrue(aoc::VentField::Point_t{ 4, 4 } == hottest[0].point);
+			Assert::IsTrue(aoc::VentField::Point_t{ 6, 4 } == hottest[1].point);
+			Assert::IsTrue(aoc::VentField::Point_t{ 7, 1 } == hottest[2].point);
+			Assert::AreEqual(uint32_t{ 3 }, hottest[1].density);
+			Assert::AreEqual(uint32_t{ 2 }, hottest[2].density);
+		}
+
+		Assert::AreEqual(size_t{ 39 }, field.hottest(1000).size());
+	}
+
+	TEST_METHOD(SweepRespectsFormations)
+	{
+		constexpr auto example_str =
+			"0,9 -> 5,9\n"
+			"8,0 -> 0,8\n"
+			"9,4 -> 3,4\n"
+			"2,2 -> 2,1\n"
+			"7,0 -> 7,4\n"
+			"6,4 -> 2,0\n"
+			"0,9 -> 2,9\n"
+			"3,4 -> 1,4\n"
+			"0,0 -> 8,8\n"
+			"5,5 -> 8,2";
+
+		std::stringstream straight_data{ example_str };
+		Assert::AreEqual(uint32_t{ 5 }, aoc::VentAnalyzer{ straight_data }
+			.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>(aoc::VentAnalyzer::DensityBackend::sweep));
+
+		// Rising and falling diagonals can cross between lattice points.
+		std::stringstream diagonal_data{ "0,0 -> 10,10\n0,1 -> 1,0\n0,2 -> 2,0" };
+		Assert::AreEqual(uint32_t{ 1 }, aoc::VentAnalyzer{ diagonal_data }.score<aoc::VentAnalyzer::diagonal>(aoc::VentAnalyzer::DensityBackend::sweep));
+	}
+
+	TEST_METHOD(SweepHandlesLinesAcrossTheWholeCoordinateRange)
+	{
+		constexpr auto all_formations = aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal;
+
+		// Four lines meet at (2000000000,2000000000), and the vertical one crosses the other three just beside it. The last
+		// line overlaps the first along 2000000001 points, two of which are crossings too.
+		constexpr auto data_str =
+			"0,0 -> 4000000000,4000000000\n"
+			"0,4000000000 -> 4000000000,0\n"
+			"0,2000000000 -> 4000000000,2000000000\n"
+			"2000000001,0 -> 2000000001,4000000000\n"
+			"1000000000,1000000000 -> 3000000000,3000000000";
+
+		for (const auto backend : { aoc::VentAnalyzer::DensityBackend::automatic, aoc::VentAnalyzer::DensityBackend::sweep }) {
+			std::stringstream data{ data_str };
+			Assert::AreEqual(uint32_t{ 2000000003 }, aoc::VentAnalyzer{ data }.score<all_formations>(backend));
+		}
+	}
 };
 
 TEST_CLASS(FloorHeightAnalyserTests)
@@ -507,6 +865,240 @@ public:
 
 		Assert::AreEqual(size_t{ 4 }, minima.size());
 	}
+
+	// Rows of random digits, without a trailing newline. Each cell is a 9 with probability ridge_fraction on top of the
+	// uniform heights; raising it walls off more basins.
+	static std::string random_height_map(size_t rows, size_t cols, uint32_t seed, double ridge_fraction = 0.0)
+	{
+		auto generator = std::mt19937{ seed };
+		auto is_ridge = std::bernoulli_distribution{ ridge_fraction };
+		auto height = std::uniform_int_distribution<int>{ 0, 9 };
+
+		auto out = std::string{};
+		out.reserve(rows * (cols + 1));
+		for (size_t r = 0; r < rows; ++r) {
+			if (r > 0) {
+				out += '\n';
+			}
+
+			for (size_t c = 0; c < cols; ++c) {
+				out += is_ridge(generator) ? '9' : static_cast<char>('0' + height(generator));
+			}
+		}
+
+		return out;
+	}
+
+	template<typename Stencil_T, typename Minimum_T>
+	static void _assert_column_kernel_matches_stencil_walk(const std::string& data_str)
+	{
+		constexpr auto radius = Stencil_T::radius;
+		using Analyser_t = aoc::FloorHeightAnalyser<uint8_t, radius, arma::Mat<uint8_t>, Stencil_T, Minimum_T>;
+		using TiledAnalyser_t = aoc::FloorHeightAnalyser<uint8_t, radius, aoc::TiledGrid<uint8_t, 16>, Stencil_T, Minimum_T>;
+
+		std::stringstream data(data_str);
+		std::stringstream tiled_data(data_str);
+
+		const auto minima = Analyser_t{}.load(data).find_minima();
+		const auto tiled_minima = TiledAnalyser_t{}.load(tiled_data).find_minima();
+
+		auto points = std::vector<aoc::Point3D<size_t>>(minima.begin(), minima.end());
+		auto tiled_points = std::vector<aoc::Point3D<size_t>>(tiled_minima.begin(), tiled_minima.end());
+		std::sort(points.begin(), points.end());
+		std::sort(tiled_points.begin(), tiled_points.end());
+
+		Assert::IsTrue(points == tiled_points);
+	}
+
+	TEST_METHOD(NeighbourhoodAndTiesArePolicies)
+	{
+		constexpr auto data_str =
+			"313\n"
+			"121\n"
+			"313";
+
+		using Mat_t = arma::Mat<uint8_t>;
+		using Four_t = aoc::stencil::FourConnected<1>;
+		using Eight_t = aoc::stencil::EightConnected<1>;
+
+		std::stringstream four_data(data_str);
+		std::stringstream eight_data(data_str);
+		std::stringstream non_strict_data(data_str);
+
+		// The 1s are lower than the cells beside them, but each is level with its diagonal neighbours.
+		Assert::AreEqual(size_t{ 4 }, aoc::FloorHeightAnalyser<uint8_t, 1, Mat_t, Four_t, aoc::StrictMinimum>{}.load(four_data).find_minima().size());
+		Assert::AreEqual(size_t{ 0 }, aoc::FloorHeightAnalyser<uint8_t, 1, Mat_t, Eight_t, aoc::StrictMinimum>{}.load(eight_data).find_minima().size());
+		Assert::AreEqual(size_t{ 4 }, aoc::FloorHeightAnalyser<uint8_t, 1, Mat_t, Eight_t, aoc::NonStrictMinimum>{}.load(non_strict_data).find_minima().size());
+	}
+
+	TEST_METHOD(ColumnKernelMatchesStencilWalkForEveryPolicy)
+	{
+		const auto data_str = random_height_map(90, 70, 99);
+
+		_assert_column_kernel_matches_stencil_walk<aoc::stencil::FourConnected<1>, aoc::StrictMinimum>(data_str);
+		_assert_column_kernel_matches_stencil_walk<aoc::stencil::FourConnected<2>, aoc::NonStrictMinimum>(data_str);
+		_assert_column_kernel_matches_stencil_walk<aoc::stencil::EightConnected<1>, aoc::StrictMinimum>(data_str);
+		_assert_column_kernel_matches_stencil_walk<aoc::stencil::EightConnected<1>, aoc::NonStrictMinimum>(data_str);
+		_assert_column_kernel_matches_stencil_walk<aoc::stencil::Window<2>, aoc::StrictMinimum>(data_str);
+	}
+
+	template<size_t KERNEL_SIZE>
+	static void _assert_scanner_matches_analyser(const std::string& data_str)
+	{
+		std::stringstream data(data_str);
+		const auto minima = aoc::FloorHeightAnalyser<uint8_t, KERNEL_SIZE>{}.load(data).find_minima();
+		auto expected = std::vector<aoc::Point3D<size_t>>(minima.begin(), minima.end());
+
+		auto streamed = std::vector<aoc::Point3D<size_t>>{};
+		std::stringstream stream(data_str);
+		aoc::FloorHeightScanner<uint8_t, KERNEL_SIZE>{}.scan(stream, [&streamed](const auto& minimum) { streamed.push_back(minimum); });
+
+		auto mapped = std::vector<aoc::Point3D<size_t>>{};
+		aoc::FloorHeightScanner<uint8_t, KERNEL_SIZE>{}.scan(std::string_view{ data_str }, [&mapped](const auto& minimum) { mapped.push_back(minimum); });
+
+		// The scanner reports minima row by row, the analyser column by column.
+		std::sort(expected.begin(), expected.end());
+		std::sort(streamed.begin(), streamed.end());
+		Assert::IsTrue(expected == streamed);
+		Assert::IsTrue(std::is_sorted(mapped.begin(), mapped.end(), [](const auto& left, const auto& right) {
+			return std::tie(left.y, left.x) < std::tie(right.y, right.x);
+			}));
+		std::sort(mapped.begin(), mapped.end());
+		Assert::IsTrue(expected == mapped);
+	}
+
+	TEST_METHOD(ScannerFindsSampleMinimaAsRowsArrive)
+	{
+		std::stringstream data(
+			"2199943210\r\n"
+			"3987894921\r\n"
+			"9856789892\r\n"
+			"8767896789\r\n"
+			"9899965678\r\n");
+
+		auto risk = size_t{ 0 };
+		auto scanner = aoc::FloorHeightScanner<uint8_t, 1>{};
+		scanner.scan(data, [&risk](const auto& minimum) { risk += minimum.z + 1; });
+
+		Assert::AreEqual(size_t{ 15 }, risk);
+		Assert::AreEqual(size_t{ 5 }, scanner.rows());
+		Assert::AreEqual(size_t{ 10 }, scanner.cols());
+		Assert::AreEqual(size_t{ 15 }, aoc::Submarine{}.boat_systems().lava_tube_smoke_risk(std::string_view{ "2199943210\n3987894921\n9856789892\n8767896789\n9899965678" }));
+	}
+
+	TEST_METHOD(ScannerIgnoresEmptyInput)
+	{
+		std::stringstream data;
+
+		auto count = size_t{ 0 };
+		auto scanner = aoc::FloorHeightScanner<uint8_t, 1>{};
+		scanner.scan(data, [&count](const auto&) { ++count; });
+
+		Assert::AreEqual(size_t{ 0 }, count);
+		Assert::AreEqual(size_t{ 0 }, scanner.rows());
+
+		std::stringstream empty_stream;
+		Assert::AreEqual(size_t{ 0 }, aoc::Submarine{}.boat_systems().lava_tube_smoke_risk(empty_stream));
+		Assert::AreEqual(size_t{ 0 }, aoc::Submarine{}.boat_systems().lava_tube_smoke_risk(std::string_view{}));
+	}
+
+	TEST_METHOD(ScannerMatchesAnalyser)
+	{
+		// Larger than one read block, so rows are split across reads.
+		const auto data_str = random_height_map(300, 301, 4242);
+
+		_assert_scanner_matches_analyser<1>(data_str);
+		_assert_scanner_matches_analyser<2>(data_str);
+		_assert_scanner_matches_analyser<1>("5");
+		_assert_scanner_matches_analyser<2>("1\n0");
+		_assert_scanner_matches_analyser<2>("9190");
+	}
+
+	TEST_METHOD(ScannerRejectsRaggedRows)
+	{
+		std::stringstream data("123\n45\n678");
+
+		try {
+			aoc::FloorHeightScanner<uint8_t, 1>{}.scan(data, [](const auto&) {});
+			Assert::Fail(L"Expected a ParseException");
+		}
+		catch (const aoc::ParseException& e) {
+			Assert::AreEqual(size_t{ 2 }, e.line_number);
+			Assert::IsTrue(data.fail());
+		}
+	}
+
+	TEST_METHOD(SampleBasinsAreLabelled)
+	{
+		std::stringstream data(
+			"2199943210\n"
+			"3987894921\n"
+			"9856789892\n"
+			"8767896789\n"
+			"9899965678");
+
+		const auto basins = aoc::FloorHeightAnalyser<uint8_t, 1>{}.load(data).find_basins();
+
+		Assert::AreEqual(size_t{ 4 }, basins.count());
+		Assert::AreEqual(size_t{ 1134 }, basins.largest_product(3));
+
+		// Coordinates are padded by one cell. The basin at the top left is found first.
+		Assert::AreEqual(uint32_t{ 1 }, basins.label(1, 1));
+		Assert::AreEqual(size_t{ 3 }, basins.size_of(basins.label(1, 1)));
+		Assert::AreEqual(size_t{ 9 }, basins.size_of(basins.label(1, 10)));
+		Assert::AreEqual(basins.label(3, 3), basins.label(4, 2));
+		Assert::AreEqual(aoc::FloorHeightAnalyser<uint8_t, 1>::Basins::no_basin, basins.label(1, 3));
+		Assert::AreEqual(aoc::FloorHeightAnalyser<uint8_t, 1>::Basins::no_basin, basins.label(0, 0));
+	}
+
+	TEST_METHOD(BandedLabellingMatchesSerialLabelling)
+	{
+		// Long runs without a 9 make basins that span many bands.
+		const auto data_str = random_height_map(120, 400, 777, 0.25);
+
+		std::stringstream data(data_str);
+		const auto analyser = aoc::FloorHeightAnalyser<uint8_t, 1>{}.load(data);
+
+		auto pool = aoc::ThreadPool{ 4 };
+		const auto serial = analyser.find_basins();
+		const auto banded = analyser.find_basins(pool);
+
+		Assert::IsTrue(serial.count() > 1);
+		Assert::IsTrue(serial.sizes() == banded.sizes());
+		Assert::IsTrue(std::equal(serial.labels().begin(), serial.labels().end(), banded.labels().begin()));
+
+		const auto total = std::accumulate(serial.sizes().begin(), serial.sizes().end(), size_t{ 0 });
+		const auto non_nines = static_cast<size_t>(std::count_if(data_str.begin(), data_str.end(), [](auto c) { return c >= '0' && c < '9'; }));
+		Assert::AreEqual(non_nines, total);
+	}
+
+	TEST_METHOD(BandedSearchFindsTheSameMinima)
+	{
+		// Big enough for several bands and for columns longer than one mask block.
+		const auto data_str = random_height_map(150, 300, 12345);
+
+		std::stringstream data(data_str);
+		std::stringstream tiled_data(data_str);
+
+		const auto analyser = aoc::FloorHeightAnalyser<uint8_t, 1>{}.load(data);
+		auto pool = aoc::ThreadPool{ 4 };
+
+		const auto expected = aoc::FloorHeightAnalyser<uint8_t, 1, aoc::TiledGrid<uint8_t, 16>>{}.load(tiled_data).find_minima();
+		const auto serial = analyser.find_minima();
+		const auto banded = analyser.find_minima(pool);
+
+		Assert::IsTrue(expected.size() > 0);
+		Assert::AreEqual(expected.size(), serial.size());
+		Assert::AreEqual(expected.size(), banded.size());
+		Assert::IsTrue(std::equal(serial.begin(), serial.end(), banded.begin()));
+
+		// The tiled grid is walked in its own order, so compare the minima as sets.
+		auto expected_points = std::vector<aoc::Point3D<size_t>>(expected.begin(), expected.end());
+		auto serial_points = std::vector<aoc::Point3D<size_t>>(serial.begin(), serial.end());
+		std::sort(expected_points.begin(), expected_points.end());
+		std::sort(serial_points.begin(), serial_points.end());
+		Assert::IsTrue(expected_points == serial_points);
+	}
 };
 
 }
@@ -517,6 +1109,22 @@ TEST_CLASS(DiagnosticLog)
 {
 public:
 
+	TEST_METHOD(LoadPackedEntries)
+	{
+		constexpr auto words = std::array<uint64_t, 12>{
+			0b00100, 0b11110, 0b10110, 0b10111, 0b10101, 0b01111, 0b00111, 0b11100, 0b10000, 0b11001, 0b00010, 0b01010 };
+
+		auto log = aoc::DiagnosticLog{};
+		log.load(std::array<uint64_t, 1>{ 0b111 }, 2);
+		log.load(words, 5);
+
+		Assert::AreEqual(size_t{ 12 }, log.size());
+		Assert::AreEqual(uint32_t{ 5 }, log.width());
+		Assert::AreEqual(size_t{ 7 }, log.count_ones(0));
+		Assert::AreEqual(uint32_t{ 230 }, aoc::Submarine{}.boat_systems().life_support_rating(log));
+		Assert::ExpectException<aoc::OutOfRangeException>([&log, &words]() { log.load(words, 65); });
+	}
+
 	TEST_METHOD(ReadLogEntriedFromStream)
 	{
 		std::stringstream ss("111011110101");
@@ -632,5 +1240,137 @@ public:
 
 		Assert::IsTrue(std::equal(expected.begin(), expected.end(), least_frequent_bits.begin()));
 	}
+
+	TEST_METHOD(EntryWidthIsTakenFromTheLog)
+	{
+		std::stringstream ss("1010000000000000000000000000000000000000000000000000000000000011\n"
+			"0010000000000000000000000000000000000000000000000000000000000001\n"
+			"1000000000000000000000000000000000000000000000000000000000000001");
+
+		const auto log = aoc::DiagnosticLog{ ss };
+		Assert::AreEqual(uint32_t{ 64 }, log.width());
+
+		const auto most_frequent_bits = log.get_most_frequent_bits();
+		Assert::AreEqual(uint64_t{ 0xA000000000000001 }, aoc::DiagnosticLog::entry_as<uint64_t>(most_frequent_bits));
+		Assert::AreEqual(uint64_t{ 0x5FFFFFFFFFFFFFFE }, aoc::DiagnosticLog::flipped_entry_as<uint64_t>(most_frequent_bits));
+	}
+
+	TEST_METHOD(EntriesOfDifferentWidthsCauseException)
+	{
+		std::stringstream ss("10101\n0101");
+		auto log = aoc::DiagnosticLog{};
+
+		Assert::ExpectException<aoc::Exception>([&]() { log.load(ss); });
+		Assert::AreEqual(size_t{ 0 }, log.size());
+	}
+
+	TEST_METHOD(BitSlicedColumnsMatchTheEntries)
+	{
+		// Enough entries to need more than one word per column.
+		auto ss = std::stringstream{};
+		for (auto i = 0; i < 150; ++i) {
+			ss << std::bitset<3>(i % 8).to_string() << "\n";
+		}
+
+		const auto log = aoc::DiagnosticLog{ ss };
+
+		Assert::AreEqual(size_t{ 150 }, log.size());
+		Assert::AreEqual(size_t{ 3 }, log.column(0).size());
+
+		for (auto bit = uint32_t{ 0 }; bit < log.width(); ++bit) {
+			const auto expected = std::count_if(log.begin(), log.end(), [bit](const auto& entry) { return entry[bit]; });
+			Assert::AreEqual(static_cast<size_t>(expected), log.count_ones(bit));
+		}
+
+		Assert::ExpectException<aoc::OutOfRangeException>([&log]() { log.column(3); });
+	}
+
+	TEST_METHOD(TrieCountsEntriesByPrefix)
+	{
+		std::stringstream ss("00100\n11110\n10110\n10111\n10101\n01111\n00111\n11100\n10000\n11001\n00010\n01010");
+		auto trie = aoc::DiagnosticTrie{ aoc::DiagnosticLog{ ss } };
+
+		Assert::AreEqual(size_t{ 12 }, trie.size());
+		Assert::AreEqual(size_t{ 7 }, trie.count_with_prefix({ 1 }));
+		Assert::AreEqual(size_t{ 3 }, trie.count_with_prefix({ 1,0,1 }));
+		Assert::AreEqual(size_t{ 0 }, trie.count_with_prefix({ 0,1,1,1,0 }));
+
+		trie.insert({ 0,1,1,1,0 });
+		Assert::AreEqual(size_t{ 1 }, trie.count_with_prefix({ 0,1,1,1,0 }));
+
+		Assert::ExpectException<aoc::InvalidArgException>([&trie]() { trie.insert({ 1,0,1 }); });
+		Assert::ExpectException<aoc::Exception>([]() { aoc::DiagnosticTrie{}.select([](auto, auto) { return true; }); });
+	}
+
+	TEST_METHOD(StreamedStatsGivePowerConsumption)
+	{
+		std::stringstream ss("00100\n11110\n10110\n10111\n10101\n01111\n00111\n11100\n10000\n11001\n00010\n01010");
+
+		auto stats = aoc::DiagnosticStats{};
+		stats.add(ss);
+
+		Assert::AreEqual(uint64_t{ 12 }, stats.size());
+		Assert::AreEqual(uint64_t{ 7 }, stats.count_ones(0));
+		Assert::AreEqual(uint32_t{ 198 }, aoc::Submarine{}.boat_systems().power_consumption(stats));
+	}
+
+	TEST_METHOD(MergedStatsMatchStatsOverTheWholeLog)
+	{
+		std::stringstream shard_1("00100\n11110\n10110\n10111\n10101");
+		std::stringstream shard_2("01111\n00111\n11100\n10000\n11001\n00010\n01010");
+
+		auto stats_1 = aoc::DiagnosticStats{};
+		stats_1.add(shard_1);
+
+		auto stats_2 = aoc::DiagnosticStats{};
+		stats_2.add(shard_2);
+
+		auto merged = aoc::DiagnosticStats{};
+		merged.merge(stats_1);
+		merged.merge(stats_2);
+
+		Assert::AreEqual(uint64_t{ 12 }, merged.size());
+		Assert::IsTrue(aoc::DiagnosticLog::Entry_t{ 1,0,1,1,0 } == merged.get_most_frequent_bits());
+		Assert::IsTrue(aoc::DiagnosticLog::Entry_t{ 0,1,0,0,1 } == merged.get_least_frequent_bits());
+
+		auto three_bit_stats = aoc::DiagnosticStats{};
+		three_bit_stats.add({ 1,0,1 });
+		Assert::ExpectException<aoc::InvalidArgException>([&merged, &three_bit_stats]() { merged.merge(three_bit_stats); });
+	}
+
+	TEST_METHOD(BulkParserReportsFirstInvalidLine)
+	{
+		auto log = aoc::DiagnosticLog{};
+
+		try {
+			log.load(std::string_view{ "0101010101\r\n1111100000\r\n\r\n0000011111\r\n0000021111\r\n0000000000\r\n" });
+			Assert::Fail();
+		}
+		catch (const aoc::ParseException& e) {
+			Assert::AreEqual(size_t{ 5 }, e.line_number);
+		}
+
+		Assert::AreEqual(size_t{ 0 }, log.size());
+	}
+
+	TEST_METHOD(BulkParserMatchesStreamExtraction)
+	{
+		// Wide entries exercise the eight-characters-at-a-time path, and enough of them to need several blocks.
+		auto text = std::string{};
+		auto expected = std::vector<aoc::DiagnosticLog::Entry_t>{};
+		for (auto i = uint64_t{ 0 }; i < 3000; ++i) {
+			const auto line = std::bitset<61>((i * 0x9E3779B97F4A7C15) >> 3).to_string();
+			text += line + "\n";
+
+			auto ss = std::stringstream{ line };
+			ss >> expected.emplace_back();
+		}
+
+		auto ss = std::stringstream{ text };
+		const auto log = aoc::DiagnosticLog{ ss };
+
+		Assert::AreEqual(expected.size(), log.size());
+		Assert::IsTrue(std::equal(expected.begin(), expected.end(), log.begin()));
+	}
 };
 }
\ No newline at end of file
@@ -0,0 +1,452 @@
+#include "CppUnitTest.h"
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+#include "Common.hpp"
+#include "BitGrid.hpp"
+#include "Stencil.hpp"
+#include "TiledGrid.hpp"
+#include "FixedGrid.hpp"
+#include "CavernPathFinder.hpp"
+#include "BoatSystems.hpp"
+
+namespace test_grids
+{
+
+TEST_CLASS(TestBitGrid)
+{
+public:
+
+	TEST_METHOD(NewGridIsEmpty)
+	{
+		const auto grid = aoc::BitGrid(3, 70);
+
+		Assert::AreEqual(size_t{ 3 }, grid.rows());
+		Assert::AreEqual(size_t{ 70 }, grid.cols());
+		Assert::AreEqual(size_t{ 2 }, grid.words_per_row());
+		Assert::AreEqual(size_t{ 0 }, grid.count());
+		Assert::IsTrue(grid.none());
+	}
+
+	TEST_METHOD(SetResetAndFlipCells)
+	{
+		auto grid = aoc::BitGrid(2, 100);
+
+		grid.set(0, 0).set(1, 65).set(1, 99);
+		Assert::IsTrue(grid.test(0, 0));
+		Assert::IsTrue(grid.test(1, 65));
+		Assert::IsTrue(grid.test(1, 99));
+		Assert::AreEqual(size_t{ 3 }, grid.count());
+
+		grid.reset(1, 65).flip(0, 0).flip(0, 1);
+		Assert::IsFalse(grid.test(1, 65));
+		Assert::IsFalse(grid.test(0, 0));
+		Assert::IsTrue(grid.test(0, 1));
+		Assert::AreEqual(size_t{ 2 }, grid.count());
+	}
+
+	TEST_METHOD(OutOfRangeAccessThrows)
+	{
+		const auto grid = aoc::BitGrid(2, 2);
+		Assert::ExpectException<aoc::OutOfRangeException>([&grid]() { grid.at(2, 0); });
+		Assert::ExpectException<aoc::OutOfRangeException>([&grid]() { grid.at(0, 2); });
+	}
+
+	TEST_METHOD(RowOperationsAreWordParallel)
+	{
+		auto grid = aoc::BitGrid(3, 130);
+		grid.set(0, 1).set(0, 129);
+		grid.set(1, 1).set(1, 64);
+
+		grid.or_rows(2, 0).or_rows(2, 1);
+		Assert::AreEqual(size_t{ 3 }, grid.count_row(2));
+
+		grid.and_rows(0, 1);
+		Assert::AreEqual(size_t{ 1 }, grid.count_row(0));
+		Assert::IsTrue(grid.test(0, 1));
+
+		grid.xor_rows(2, 1);
+		Assert::AreEqual(size_t{ 1 }, grid.count_row(2));
+		Assert::IsTrue(grid.test(2, 129));
+	}
+
+	TEST_METHOD(InvertLeavesPaddingClear)
+	{
+		auto grid = aoc::BitGrid(2, 70);
+		grid.set(0, 3);
+
+		grid.invert();
+
+		Assert::AreEqual(size_t{ 139 }, grid.count());
+		Assert::IsFalse(grid.test(0, 3));
+	}
+
+	TEST_METHOD(GridsWithDifferentShapesCannotBeCombined)
+	{
+		auto grid = aoc::BitGrid(2, 70);
+		Assert::ExpectException<aoc::InvalidArgException>([&grid]() { grid |= aoc::BitGrid(2, 71); });
+	}
+
+	TEST_METHOD(MirrorRows)
+	{
+		auto grid = aoc::BitGrid(3, 5);
+		grid.set(0, 1).set(2, 4);
+
+		grid.mirror_rows();
+
+		Assert::IsTrue(grid.test(2, 1));
+		Assert::IsTrue(grid.test(0, 4));
+		Assert::AreEqual(size_t{ 2 }, grid.count());
+	}
+
+	TEST_METHOD(MirrorColsAcrossWordBoundaries)
+	{
+		auto grid = aoc::BitGrid(1, 150);
+		grid.set(0, 0).set(0, 63).set(0, 64).set(0, 149);
+
+		grid.mirror_cols();
+
+		Assert::IsTrue(grid.test(0, 149));
+		Assert::IsTrue(grid.test(0, 86));
+		Assert::IsTrue(grid.test(0, 85));
+		Assert::IsTrue(grid.test(0, 0));
+		Assert::AreEqual(size_t{ 4 }, grid.count());
+	}
+
+	TEST_METHOD(ShiftedMovesCellsAndDropsThoseThatFallOff)
+	{
+		auto grid = aoc::BitGrid(3, 130);
+		grid.set(0, 63).set(1, 129).set(2, 0);
+
+		const auto right = grid.shifted(0, 1);
+		Assert::IsTrue(right.test(0, 64));
+		Assert::IsTrue(right.test(2, 1));
+		Assert::AreEqual(size_t{ 2 }, right.count());
+
+		const auto left_and_up = grid.shifted(-1, -65);
+		Assert::IsTrue(left_and_up.test(0, 64));
+		Assert::AreEqual(size_t{ 1 }, left_and_up.count());
+	}
+
+	TEST_METHOD(OrthogonalNeighbourMask)
+	{
+		auto grid = aoc::BitGrid(3, 3);
+		grid.set(1, 1);
+
+		const auto mask = grid.neighbour_mask<aoc::BitGrid::orthogonal>();
+
+		Assert::AreEqual(size_t{ 4 }, mask.count());
+		Assert::IsTrue(mask.test(0, 1));
+		Assert::IsTrue(mask.test(1, 0));
+		Assert::IsTrue(mask.test(1, 2));
+		Assert::IsTrue(mask.test(2, 1));
+	}
+
+	TEST_METHOD(FullNeighbourMask)
+	{
+		auto grid = aoc::BitGrid(3, 3);
+		grid.set(0, 0);
+
+		const auto mask = grid.neighbour_mask<aoc::BitGrid::orthogonal | aoc::BitGrid::diagonal>();
+
+		Assert::AreEqual(size_t{ 3 }, mask.count());
+		Assert::IsTrue(mask.test(1, 1));
+	}
+
+	TEST_METHOD(ConvertToAndFromMatrix)
+	{
+		auto mat = arma::Mat<int>(2, 3);
+		mat.fill(0);
+		mat.at(0, 2) = 1;
+		mat.at(1, 0) = 5;
+
+		const auto grid = aoc::BitGrid::from_matrix(mat);
+		Assert::AreEqual(size_t{ 2 }, grid.count());
+		Assert::IsTrue(grid.test(0, 2));
+		Assert::IsTrue(grid.test(1, 0));
+
+		const auto round_trip = grid.as_matrix<int>();
+		Assert::AreEqual(1, round_trip.at(0, 2));
+		Assert::AreEqual(1, round_trip.at(1, 0));
+		Assert::AreEqual(0, round_trip.at(0, 0));
+	}
+};
+
+TEST_CLASS(TestStencil)
+{
+public:
+
+	TEST_METHOD(StencilShapesHaveTheExpectedOffsets)
+	{
+		Assert::AreEqual(size_t{ 4 }, aoc::stencil::FourConnected<>::offsets.size());
+		Assert::AreEqual(size_t{ 8 }, aoc::stencil::EightConnected<>::offsets.size());
+		Assert::AreEqual(size_t{ 24 }, aoc::stencil::Window<2>::offsets.size());
+
+		Assert::AreEqual(std::ptrdiff_t{ -3 }, aoc::stencil::FourConnected<3>::offsets[0].row);
+		Assert::AreEqual(size_t{ 3 }, aoc::stencil::FourConnected<3>::radius);
+	}
+
+	TEST_METHOD(EveryCellIsVisitedOnceInColumnMajorOrder)
+	{
+		auto visited = std::vector<std::pair<size_t, size_t>>{};
+		aoc::stencil::for_each_cell<aoc::stencil::EightConnected<>>(4, 3, [&visited](auto r, auto c, const auto&) {
+			visited.emplace_back(r, c);
+			});
+
+		Assert::AreEqual(size_t{ 12 }, visited.size());
+		for (size_t i = 0; i < visited.size(); ++i) {
+			Assert::AreEqual(i % 4, visited[i].first);
+			Assert::AreEqual(i / 4, visited[i].second);
+		}
+	}
+
+	TEST_METHOD(OnlyBorderCellsAreBounded)
+	{
+		auto bounded = arma::Mat<int>(5, 6);
+		aoc::stencil::for_each_cell<aoc::stencil::FourConnected<>>(5, 6, [&bounded](auto r, auto c, const auto& neighbours) {
+			bounded.at(r, c) = neighbours.is_bounded() ? 1 : 0;
+			});
+
+		for (arma::uword c = 0; c < 6; ++c) {
+			for (arma::uword r = 0; r < 5; ++r) {
+				const auto is_border = r == 0 || c == 0 || r == 4 || c == 5;
+				Assert::AreEqual(is_border ? 1 : 0, bounded.at(r, c));
+			}
+		}
+	}
+
+	TEST_METHOD(NeighbourCountsMatchPositionInGrid)
+	{
+		auto counts = arma::Mat<int>(4, 4);
+		aoc::stencil::for_each_cell<aoc::stencil::EightConnected<>>(4, 4, [&counts](auto r, auto c, const auto& neighbours) {
+			auto count = 0;
+			neighbours([&count](auto, auto) { ++count; });
+			counts.at(r, c) = count;
+			});
+
+		Assert::AreEqual(3, counts.at(0, 0));
+		Assert::AreEqual(5, counts.at(0, 1));
+		Assert::AreEqual(8, counts.at(1, 1));
+		Assert::AreEqual(3, counts.at(3, 3));
+	}
+
+	TEST_METHOD(AllOfAndAnyOfIgnoreCellsOutsideTheGrid)
+	{
+		auto is_true_everywhere = true;
+		auto is_true_somewhere = true;
+		aoc::stencil::for_each_cell<aoc::stencil::Window<2>>(3, 3, [&](auto r, auto c, const auto& neighbours) {
+			is_true_everywhere &= neighbours.all_of([](auto nr, auto nc) { return nr < 3 && nc < 3; });
+			is_true_somewhere &= neighbours.any_of([](auto nr, auto nc) { return nr < 3 && nc < 3; });
+			});
+
+		Assert::IsTrue(is_true_everywhere);
+		Assert::IsTrue(is_true_somewhere);
+	}
+
+	TEST_METHOD(HaloVisitsOnlyTheUnpaddedCells)
+	{
+		using Halo_t = aoc::stencil::Halo<aoc::stencil::FourConnected<2>>;
+
+		auto padded = Halo_t::make(3, 4, 7);
+		Assert::AreEqual(arma::uword{ 7 }, padded.n_rows);
+		Assert::AreEqual(arma::uword{ 8 }, padded.n_cols);
+
+		auto visits = 0;
+		Halo_t::for_each_cell(padded.n_rows, padded.n_cols, [&](auto r, auto c, const auto& neighbours) {
+			Assert::IsFalse(neighbours.is_bounded());
+			Assert::IsTrue(r >= 2 && r < 5 && c >= 2 && c < 6);
+			++visits;
+			});
+
+		Assert::AreEqual(12, visits);
+	}
+};
+
+TEST_CLASS(TestTiledGrid)
+{
+public:
+
+	TEST_METHOD(NewGridIsFilled)
+	{
+		const auto grid = aoc::TiledGrid<int, 4>(5, 9, 3);
+
+		Assert::AreEqual(size_t{ 5 }, grid.n_rows);
+		Assert::AreEqual(size_t{ 9 }, grid.n_cols);
+		Assert::AreEqual(size_t{ 45 }, grid.n_elem);
+		Assert::AreEqual(size_t{ 2 }, grid.tile_rows());
+		Assert::AreEqual(size_t{ 3 }, grid.tile_cols());
+		Assert::AreEqual(3, grid.at(4, 8));
+	}
+
+	TEST_METHOD(RoundTripThroughMatrix)
+	{
+		auto mat = arma::Mat<int>(7, 10);
+		for (arma::uword c = 0; c < mat.n_cols; ++c) {
+			for (arma::uword r = 0; r < mat.n_rows; ++r) {
+				mat.at(r, c) = static_cast<int>(r * 100 + c);
+			}
+		}
+
+		const auto grid = aoc::TiledGrid<int, 4, aoc::TileOrder::morton>::from_matrix(mat);
+		const auto round_trip = grid.as_matrix();
+
+		for (arma::uword c = 0; c < mat.n_cols; ++c) {
+			for (arma::uword r = 0; r < mat.n_rows; ++r) {
+				Assert::AreEqual(mat.at(r, c), grid.at(r, c));
+				Assert::AreEqual(mat.at(r, c), round_trip.at(r, c));
+			}
+		}
+	}
+
+	TEST_METHOD(RowAndColumnAccessors)
+	{
+		auto grid = aoc::TiledGrid<int, 4>(6, 6);
+		for (size_t i = 0; i < 5; ++i) {
+			grid.at(2, i) = static_cast<int>(i);
+		}
+
+		for (size_t i = 0; i < 6; ++i) {
+			grid.at(i, 5) = static_cast<int>(10 * i);
+		}
+
+		Assert::AreEqual(size_t{ 4 }, grid.row_segment(2, 0).size());
+		Assert::AreEqual(size_t{ 2 }, grid.row_segment(2, 1).size());
+
+		auto row_sum = 0;
+		grid.for_each_in_row(2, [&row_sum](auto, auto value) { row_sum += value; });
+		Assert::AreEqual(30, row_sum);
+
+		auto col = std::vector<int>{};
+		grid.for_each_in_col(5, [&col](auto, auto value) { col.push_back(value); });
+		Assert::IsTrue(std::vector<int>{ 0, 10, 20, 30, 40, 50 } == col);
+	}
+
+	TEST_METHOD(RegionIsVisitedOnceTileByTile)
+	{
+		const auto grid = aoc::TiledGrid<int, 2, aoc::TileOrder::morton>(5, 5);
+
+		auto visited = std::vector<std::pair<size_t, size_t>>{};
+		grid.for_each_position(1, 4, 0, 3, [&visited](auto r, auto c) { visited.emplace_back(r, c); });
+
+		const auto expected = std::vector<std::pair<size_t, size_t>>{
+			{1, 0}, {1, 1}, {1, 2}, {2, 0}, {2, 1}, {3, 0}, {3, 1}, {2, 2}, {3, 2}
+		};
+		Assert::IsTrue(expected == visited);
+	}
+
+	TEST_METHOD(StencilVisitsEveryCellWithTheRightBounds)
+	{
+		const auto grid = aoc::TiledGrid<int, 4>(9, 7);
+
+		auto counts = arma::Mat<int>(9, 7);
+		counts.fill(0);
+		aoc::stencil::for_each_cell<aoc::stencil::FourConnected<>>(grid, [&counts](auto r, auto c, const auto& neighbours) {
+			const auto is_border = r == 0 || c == 0 || r == 8 || c == 6;
+			Assert::AreEqual(is_border, neighbours.is_bounded());
+			++counts.at(r, c);
+			});
+
+		Assert::IsTrue(std::all_of(counts.begin(), counts.end(), [](auto n) { return n == 1; }));
+	}
+
+	TEST_METHOD(PathFinderAcceptsTiledGrid)
+	{
+		const auto risks = aoc::navigation::Cavern::Grid_t{
+			{1, 1, 6, 3, 7},
+			{1, 3, 8, 1, 3},
+			{2, 1, 3, 6, 5},
+			{3, 6, 9, 4, 9},
+			{7, 4, 6, 3, 4}
+		};
+
+		const auto expected = aoc::navigation::CavernPathFinder{}.plot_course(risks).score();
+		const auto actual = aoc::navigation::CavernPathFinder{}.plot_course(aoc::TiledGrid<int, 2>::from_matrix(risks)).score();
+
+		Assert::AreEqual(expected, actual);
+	}
+
+	TEST_METHOD(FloorHeightAnalyserAcceptsTiledGrid)
+	{
+		std::stringstream data{
+			"2199943210\n"
+			"3987894921\n"
+			"9856789892\n"
+			"8767896789\n"
+			"9899965678"
+		};
+
+		const auto minima = aoc::FloorHeightAnalyser<uint8_t, 1, aoc::TiledGrid<uint8_t, 4>>{}.load(data).find_minima();
+
+		Assert::AreEqual(size_t{ 4 }, minima.size());
+		const auto risk = std::accumulate(minima.begin(), minima.end(), size_t{ 0 }, [](auto curr, const auto& p) { return curr + p.z + 1; });
+		Assert::AreEqual(size_t{ 15 }, risk);
+	}
+};
+
+TEST_CLASS(TestFixedGrid)
+{
+public:
+
+	TEST_METHOD(DimensionsAreKnownAtCompileTime)
+	{
+		using Grid_t = aoc::FixedGrid<int, 3, 4>;
+
+		static_assert(Grid_t::n_rows == 3);
+		static_assert(Grid_t::n_cols == 4);
+		static_assert(Grid_t::n_elem == 12);
+		static_assert(sizeof(Grid_t) == 12 * sizeof(int));
+
+		constexpr auto value = []() {
+			auto grid = Grid_t{ 1 };
+			grid.at(2, 3) = 5;
+			return grid.at(2, 3) + grid.at(0, 0);
+		}();
+		Assert::AreEqual(6, value);
+	}
+
+	TEST_METHOD(StorageIsColumnMajor)
+	{
+		auto grid = aoc::FixedGrid<int, 2, 3>{};
+		grid.at(1, 0) = 1;
+		grid.at(0, 1) = 2;
+
+		Assert::AreEqual(1, grid[1]);
+		Assert::AreEqual(2, grid[2]);
+
+		const auto col = grid.col(1);
+		Assert::AreEqual(size_t{ 2 }, col.size());
+		Assert::AreEqual(2, col[0]);
+	}
+
+	TEST_METHOD(RoundTripThroughMatrix)
+	{
+		const auto mat = arma::Mat<int>{ {1, 2, 3}, {4, 5, 6} };
+
+		const auto grid = aoc::FixedGrid<int, 2, 3>::from_matrix(mat);
+		Assert::AreEqual(6, grid.at(1, 2));
+
+		auto row_sum = 0;
+		grid.for_each_in_row(1, [&row_sum](auto, auto value) { row_sum += value; });
+		Assert::AreEqual(15, row_sum);
+
+		const auto round_trip = grid.as_matrix();
+		Assert::AreEqual(4, round_trip.at(1, 0));
+
+		Assert::ExpectException<aoc::InvalidArgException>([&mat]() { aoc::FixedGrid<int, 3, 3>::from_matrix(mat); });
+	}
+
+	TEST_METHOD(StencilVisitsEveryCellWithTheRightBounds)
+	{
+		const auto grid = aoc::FixedGrid<int, 4, 5>{};
+
+		auto counts = aoc::FixedGrid<int, 4, 5>{};
+		aoc::stencil::for_each_cell<aoc::stencil::EightConnected<>>(grid, [&counts](auto r, auto c, const auto& neighbours) {
+			const auto is_border = r == 0 || c == 0 || r == 3 || c == 4;
+			Assert::AreEqual(is_border, neighbours.is_bounded());
+			++counts.at(r, c);
+			});
+
+		Assert::IsTrue(std::all_of(counts.begin(), counts.end(), [](auto n) { return n == 1; }));
+	}
+};
+
+}
@@ -3,6 +3,8 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 #include "Common.hpp"
 #include "PacketDecoder.hpp"
+#include "EmbeddedInputs.hpp"
+#include "AdventOfCode.hpp"
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
@@ -369,3 +371,53 @@ public:
 	}
 };
 }
+
+namespace test_embedded_inputs
+{
+TEST_CLASS(ConstexprParsers)
+{
+	static constexpr auto _depths = std::string_view{ "199\n200\n208\n210\n200\n207\n240\n269\n260\n263\n" };
+	static constexpr auto _diagnostics = std::string_view{ "00100\r\n11110\r\n10110\r\n10111\r\n10101\r\n01111\r\n00111\r\n11100\r\n10000\r\n11001\r\n00010\r\n01010" };
+	static constexpr auto _timers = std::string_view{ "3,4,3,1,2\n" };
+
+public:
+
+	TEST_METHOD(DepthsAreParsedAndScoredAtCompileTime)
+	{
+		constexpr auto depths = aoc::embedded::parse_lines<aoc::embedded::count_lines(_depths)>(_depths);
+		static_assert(depths.size() == 10);
+		static_assert(depths.front() == 199 && depths.back() == 263);
+
+		constexpr auto depth_score = aoc::BoatSystems{}.depth_score<1>(depths.begin(), depths.end());
+		static_assert(depth_score == 7);
+
+		Assert::AreEqual(uint64_t{ 5 }, aoc::BoatSystems{}.depth_score<3>(depths.begin(), depths.end()));
+	}
+
+	TEST_METHOD(BinaryLinesIgnoreCarriageReturns)
+	{
+		constexpr auto entries = aoc::embedded::parse_binary_lines<aoc::embedded::count_lines(_diagnostics)>(_diagnostics);
+		static_assert(aoc::embedded::line_width(_diagnostics) == 5);
+		static_assert(entries.size() == 12);
+		static_assert(entries[0] == 0b00100 && entries[11] == 0b01010);
+
+		Assert::AreEqual(uint64_t{ 0b11110 }, entries[1]);
+	}
+
+	TEST_METHOD(ListIsParsedAtCompileTime)
+	{
+		constexpr auto timers = aoc::embedded::parse_list<aoc::embedded::count_fields(_timers)>(_timers);
+		static_assert(timers == std::array<uint32_t, 5>{ 3, 4, 3, 1, 2 });
+
+		Assert::AreEqual(size_t{ 5 }, timers.size());
+	}
+
+	TEST_METHOD(InvalidInputThrows)
+	{
+		Assert::ExpectException<aoc::IOException>([]() { aoc::embedded::parse_lines<2>("12\n3x\n"); });
+		Assert::ExpectException<aoc::IOException>([]() { aoc::embedded::parse_lines<3>("12\n34\n"); });
+		Assert::ExpectException<aoc::IOException>([]() { aoc::embedded::parse_binary_lines<2>("0101\n011\n"); });
+		Assert::ExpectException<aoc::IOException>([]() { aoc::embedded::parse_list<3>("1,,2"); });
+	}
+};
+}
@@ -267,6 +267,41 @@ public:
 
 		Assert::IsTrue(std::equal(expected_points.begin(), expected_points.end(), points.begin()));
 	}
+
+	TEST_METHOD(RasterizeDiagonalLinesWorks)
+	{
+		using Line_t = aoc::Line2d<uint32_t>;
+		const auto points = aoc::rasterize<Line_t::diagonal>(Line_t{ {5, 1}, { 1, 5 } });
+
+		const auto expected_points = std::vector<aoc::Point2D<uint32_t>>{ {1,5}, {2,4}, {3,3}, {4,2}, {5,1} };
+
+		Assert::AreEqual(expected_points.size(), points.size());
+		Assert::IsTrue(std::equal(expected_points.begin(), expected_points.end(), points.begin()));
+	}
+
+	TEST_METHOD(RasterizeViewIsALazyRandomAccessRange)
+	{
+		using Line_t = aoc::Line2d<uint32_t>;
+		using View_t = decltype(aoc::rasterize_view<Line_t::horizontal>(Line_t{}));
+		static_assert(std::ranges::view<View_t>);
+		static_assert(std::ranges::random_access_range<View_t>);
+		static_assert(std::ranges::sized_range<View_t>);
+
+		const auto points = aoc::rasterize_view<Line_t::vertical | Line_t::diagonal>(Line_t{ {2, 7}, { 6, 3 } });
+
+		Assert::AreEqual(size_t{ 5 }, points.size());
+		Assert::IsTrue(aoc::Point2D<uint32_t>{ 4, 5 } == points[2]);
+		Assert::IsTrue(aoc::Point2D<uint32_t>{ 6, 3 } == *std::ranges::prev(points.end()));
+		Assert::AreEqual(std::ptrdiff_t{ 3 }, std::ranges::distance(points | std::views::drop(2)));
+	}
+
+	TEST_METHOD(RasterizeViewOnlyAcceptsOrientationsInTheMask)
+	{
+		using Line_t = aoc::Line2d<uint32_t>;
+		Assert::ExpectException<aoc::Exception>([]() {
+			aoc::rasterize_view<Line_t::horizontal>(Line_t{ {1, 1}, { 1, 5 } });
+			});
+	}
 };
 
 TEST_CLASS(TestRectangle)
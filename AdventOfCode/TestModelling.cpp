@@ -53,6 +53,17 @@ public:
 		Assert::AreEqual(aoc::LanternfishShoal::Size_t{ 26 }, number_of_fish);
 	}
 
+	TEST_METHOD(ShoalCanBeLoadedFromParsedTimers)
+	{
+		constexpr auto timers = std::array<uint32_t, 5>{ 3, 4, 3, 1, 2 };
+		auto shoal = aoc::LanternfishShoal{}.load(timers);
+
+		const auto number_of_fish = aoc::LanternfishShoalModel{ shoal }.run_for(std::chrono::days(18)).shoal_size();
+
+		Assert::AreEqual(aoc::LanternfishShoal::Size_t{ 26 }, number_of_fish);
+		Assert::ExpectException<aoc::Exception>([]() { aoc::LanternfishShoal{}.load(std::array<uint32_t, 2>{ 3, 9 }); });
+	}
+
 	TEST_METHOD(DecrementingTimeToSpawningBelowZeroResetsTime)
 	{
 		auto fish = aoc::Lanternfish{ 0 };
@@ -83,6 +94,16 @@ public:
 		Assert::AreEqual(size_t{ 2 }, best_position);
 		Assert::AreEqual(uint32_t{ 37 }, cost);
 	}
+
+	TEST_METHOD(LoadCrabPositionsFromParsedList)
+	{
+		constexpr auto positions = std::array<uint32_t, 10>{ 16, 1, 2, 0, 4, 2, 7, 1, 2, 14 };
+
+		const auto [best_position, cost] = aoc::CrabSorter{}.load(positions).best_position_and_cost([](uint32_t distance) { return distance; });
+
+		Assert::AreEqual(size_t{ 2 }, best_position);
+		Assert::AreEqual(uint32_t{ 37 }, cost);
+	}
 };
 
 TEST_CLASS(TestDumboOctopusModel)
@@ -117,6 +117,26 @@ public:
 			}
 		}
 	}
+
+	TEST_METHOD(AsBitGrid)
+	{
+		auto paper = aoc::Paper{};
+
+		paper.mark({ 1, 2 });
+		paper.mark({ 3, 4 });
+		paper.mark({ 5, 6 });
+
+		const auto grid = paper.as_bit_grid();
+		Assert::AreEqual(size_t{ 7 }, grid.cols(), L"Incorrect column count");
+		Assert::AreEqual(size_t{ 7 }, grid.rows(), L"Incorrect row count");
+		Assert::AreEqual(paper.mark_count(), grid.count());
+
+		for (auto r = size_t{ 0 }; r < grid.rows(); ++r) {
+			for (auto c = size_t{ 0 }; c < grid.cols(); ++c) {
+				Assert::AreEqual(paper.read({ c, r }), grid.test(r, c));
+			}
+		}
+	}
 };
 
 TEST_CLASS(TestFoldSequence)
@@ -0,0 +1,321 @@
+#include "CppUnitTest.h"
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+#include "Common.hpp"
+#include "Pipeline.hpp"
+#include "AdventOfCode.hpp"
+#include "Executor.hpp"
+#include "AsyncSubmarine.hpp"
+
+using namespace std::string_literals;
+using namespace std::chrono_literals;
+
+namespace test_pipeline
+{
+
+TEST_CLASS(TestBoundedQueue)
+{
+public:
+
+	TEST_METHOD(ValuesComeOutInTheOrderTheyWentIn)
+	{
+		auto queue = aoc::BoundedQueue<int>(3);
+		queue.push(1);
+		queue.push(2);
+		queue.push(3);
+
+		Assert::AreEqual(1, *queue.pop());
+		Assert::AreEqual(2, *queue.pop());
+		Assert::AreEqual(3, *queue.pop());
+	}
+
+	TEST_METHOD(ClosedQueueRefusesPushesAndDrains)
+	{
+		auto queue = aoc::BoundedQueue<int>(2);
+		queue.push(1);
+		queue.close();
+
+		Assert::IsFalse(queue.push(2));
+		Assert::AreEqual(1, *queue.pop());
+		Assert::IsFalse(queue.pop().has_value());
+	}
+
+	TEST_METHOD(FullQueueBlocksProducerUntilConsumed)
+	{
+		auto queue = aoc::BoundedQueue<int>(1);
+		queue.push(1);
+
+		auto pushed_second = std::atomic<bool>{ false };
+		auto producer = std::jthread{ [&queue, &pushed_second]() {
+			queue.push(2);
+			pushed_second = true;
+			} };
+
+		std::this_thread::sleep_for(20ms);
+		Assert::IsFalse(pushed_second.load());
+
+		Assert::AreEqual(1, *queue.pop());
+		producer.join();
+
+		Assert::IsTrue(pushed_second.load());
+		Assert::AreEqual(2, *queue.pop());
+	}
+};
+
+TEST_CLASS(TestPipeline)
+{
+	using Pipeline_t = aoc::Pipeline<int, std::string, std::vector<int>, int>;
+
+	static Pipeline_t _make_digit_sum_pipeline()
+	{
+		return Pipeline_t(
+			[](const int& input) { return std::to_string(input); },
+			[](std::string digits) {
+				auto out = std::vector<int>{};
+				std::transform(digits.begin(), digits.end(), std::back_inserter(out), [](auto c) { return c - '0'; });
+				return out;
+			},
+			[](std::vector<int> digits) { return std::accumulate(digits.begin(), digits.end(), 0); }
+		);
+	}
+
+public:
+
+	TEST_METHOD(ResultsAreInInputOrder)
+	{
+		auto pipeline = _make_digit_sum_pipeline();
+		pipeline.workers(Pipeline_t::Stage::read, 2)
+			.workers(Pipeline_t::Stage::parse, 3)
+			.workers(Pipeline_t::Stage::solve, 4)
+			.queue_capacity(2);
+
+		auto inputs = std::vector<int>(200);
+		std::iota(inputs.begin(), inputs.end(), 0);
+
+		const auto results = pipeline.run(inputs);
+
+		Assert::AreEqual(inputs.size(), results.size());
+		for (size_t i = 0; i < inputs.size(); ++i) {
+			const auto digits = std::to_string(inputs[i]);
+			const auto expected = std::accumulate(digits.begin(), digits.end(), 0, [](auto curr, auto c) { return curr + c - '0'; });
+			Assert::AreEqual(expected, results[i]);
+		}
+	}
+
+	TEST_METHOD(EmptyBatchGivesNoResults)
+	{
+		auto pipeline = _make_digit_sum_pipeline();
+		Assert::IsTrue(pipeline.run({}).empty());
+	}
+
+	TEST_METHOD(EveryStageRecordsItsLatency)
+	{
+		auto pipeline = _make_digit_sum_pipeline();
+		pipeline.run({ 1, 22, 333 });
+
+		for (auto stage : { Pipeline_t::Stage::read, Pipeline_t::Stage::parse, Pipeline_t::Stage::solve }) {
+			const auto& stats = pipeline.stats(stage);
+			Assert::AreEqual(size_t{ 3 }, stats.count);
+			Assert::IsTrue(stats.min <= stats.mean());
+			Assert::IsTrue(stats.mean() <= stats.max);
+		}
+	}
+
+	TEST_METHOD(StageExceptionIsRethrown)
+	{
+		auto pipeline = Pipeline_t(
+			[](const int& input) { return std::to_string(input); },
+			[](std::string digits) -> std::vector<int> {
+				if (digits == "13") {
+					throw aoc::IOException("Unlucky input");
+				}
+				return { 1 };
+			},
+			[](std::vector<int> digits) { return digits.front(); }
+		);
+		pipeline.workers(Pipeline_t::Stage::parse, 2).queue_capacity(1);
+
+		auto inputs = std::vector<int>(50);
+		std::iota(inputs.begin(), inputs.end(), 0);
+
+		Assert::ExpectException<aoc::IOException>([&pipeline, &inputs]() { pipeline.run(inputs); });
+	}
+
+	TEST_METHOD(StagesNeedAtLeastOneWorker)
+	{
+		auto pipeline = _make_digit_sum_pipeline();
+		Assert::ExpectException<aoc::InvalidArgException>([&pipeline]() { pipeline.workers(Pipeline_t::Stage::solve, 0); });
+	}
+
+	TEST_METHOD(VentDetectionBatch)
+	{
+		constexpr auto vents =
+			"0,9 -> 5,9\n"
+			"8,0 -> 0,8\n"
+			"9,4 -> 3,4\n"
+			"2,2 -> 2,1\n"
+			"7,0 -> 7,4\n"
+			"6,4 -> 2,0\n"
+			"0,9 -> 2,9\n"
+			"3,4 -> 1,4\n"
+			"0,0 -> 8,8\n"
+			"5,5 -> 8,2";
+
+		using VentPipeline_t = aoc::Pipeline<std::string, std::string, std::shared_ptr<std::istream>, uint32_t>;
+		auto pipeline = VentPipeline_t(
+			[](const std::string& input) { return input; },
+			[](std::string data) -> std::shared_ptr<std::istream> { return std::make_shared<std::stringstream>(std::move(data)); },
+			[](std::shared_ptr<std::istream> data) {
+				return aoc::Submarine{}.boat_systems().detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>(*data);
+			}
+		);
+
+		const auto scores = pipeline.run(std::vector<std::string>(8, vents));
+
+		Assert::IsTrue(std::all_of(scores.begin(), scores.end(), [](auto score) { return score == 5; }));
+	}
+};
+
+TEST_CLASS(TestThreadPool)
+{
+public:
+
+	TEST_METHOD(SubmittedWorkReturnsItsResult)
+	{
+		auto pool = aoc::ThreadPool(3);
+
+		auto futures = std::vector<std::future<int>>{};
+		for (auto i = 0; i < 20; ++i) {
+			futures.push_back(pool.submit([i]() { return i * i; }));
+		}
+
+		for (auto i = 0; i < 20; ++i) {
+			Assert::AreEqual(i * i, futures[i].get());
+		}
+	}
+
+	TEST_METHOD(ExceptionsAreDeliveredThroughTheFuture)
+	{
+		auto pool = aoc::ThreadPool(1);
+		auto result = pool.submit([]() -> int { throw aoc::IOException("Bad input"); });
+
+		Assert::ExpectException<aoc::IOException>([&result]() { result.get(); });
+	}
+
+	TEST_METHOD(CancelledWorkNeverStarts)
+	{
+		auto pool = aoc::ThreadPool(1);
+
+		auto release = std::promise<void>{};
+		auto blocker = pool.submit([gate = release.get_future().share()]() { gate.wait(); return 0; });
+
+		auto source = aoc::CancellationSource{};
+		auto has_run = std::atomic<bool>{ false };
+		auto cancelled = pool.submit([&has_run]() { has_run = true; return 1; }, source.token());
+
+		source.cancel();
+		release.set_value();
+
+		Assert::AreEqual(0, blocker.get());
+		Assert::ExpectException<aoc::CancelledException>([&cancelled]() { cancelled.get(); });
+		Assert::IsFalse(has_run.load());
+	}
+
+	TEST_METHOD(FailedChunkWaitsForTheOthers)
+	{
+		auto pool = aoc::ThreadPool(4);
+		auto finished = std::atomic<int>{ 0 };
+
+		Assert::ExpectException<aoc::IOException>([&pool, &finished]() {
+			aoc::for_each_chunk(pool, 4, 1, [&finished](size_t chunk_begin, size_t) {
+				if (chunk_begin == 0) {
+					throw aoc::IOException("Bad chunk");
+				}
+
+				std::this_thread::sleep_for(20ms);
+				return ++finished;
+				});
+			});
+
+		Assert::AreEqual(3, finished.load());
+	}
+
+	TEST_METHOD(DefaultTokenIsNeverCancelled)
+	{
+		Assert::IsFalse(aoc::CancellationToken{}.is_cancelled());
+	}
+};
+
+TEST_CLASS(TestAsyncSubmarine)
+{
+	static constexpr auto _bingo_game =
+		"7,4,9,5,11,17,23,2,0,14,21,24,10,16,13,6,15,25,12,22,18,20,8,19,3,26,1\n"
+		"\n"
+		"22 13 17 11  0\n"
+		"8  2 23  4 24\n"
+		"21  9 14 16  7\n"
+		"6 10  3 18  5\n"
+		"1 12 20 15 19\n"
+		"\n"
+		"3 15  0  2 22\n"
+		"9 18 13 17  5\n"
+		"19  8  7 25 23\n"
+		"20 11 10 24  4\n"
+		"14 21 16 12  6\n"
+		"\n"
+		"14 21 17 24  4\n"
+		"10 16 15  9 19\n"
+		"18  8 23 26 20\n"
+		"22 11 13  6  5\n"
+		"2  0 12  3  7";
+
+	static constexpr auto _vents =
+		"0,9 -> 5,9\n"
+		"8,0 -> 0,8\n"
+		"9,4 -> 3,4\n"
+		"2,2 -> 2,1\n"
+		"7,0 -> 7,4\n"
+		"6,4 -> 2,0\n"
+		"0,9 -> 2,9\n"
+		"3,4 -> 1,4\n"
+		"0,0 -> 8,8\n"
+		"5,5 -> 8,2";
+
+public:
+
+	TEST_METHOD(ManyAnalysesCanBeInFlightAtOnce)
+	{
+		const auto sub = aoc::AsyncSubmarine{ std::make_shared<aoc::ThreadPool>(4) };
+
+		auto vents = std::vector<std::future<uint32_t>>{};
+		for (auto i = 0; i < 10; ++i) {
+			vents.push_back(sub.detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>(_vents));
+		}
+
+		auto risk = sub.lava_tube_smoke_risk("2199943210\n3987894921\n9856789892\n8767896789\n9899965678");
+		auto win = sub.bingo_score(_bingo_game, aoc::AsyncSubmarine::BingoStrategy::play_to_win);
+		auto lose = sub.bingo_score(_bingo_game, aoc::AsyncSubmarine::BingoStrategy::play_to_lose);
+
+		for (auto& score : vents) {
+			Assert::AreEqual(uint32_t{ 12 }, score.get());
+		}
+
+		Assert::AreEqual(size_t{ 15 }, risk.get());
+		Assert::AreEqual(uint32_t{ 4512 }, *win.get());
+		Assert::AreEqual(uint32_t{ 1924 }, *lose.get());
+	}
+
+	TEST_METHOD(CancelledAnalysisThrows)
+	{
+		const auto sub = aoc::AsyncSubmarine{ std::make_shared<aoc::ThreadPool>(1) };
+
+		auto source = aoc::CancellationSource{};
+		source.cancel();
+
+		auto score = sub.detect_vents<aoc::VentAnalyzer::horizontal>(_vents, source.token());
+
+		Assert::ExpectException<aoc::CancelledException>([&score]() { score.get(); });
+	}
+};
+
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum class TileOrder
+{
+	row_major,
+	morton
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A 2D grid stored as TILE_SIZE x TILE_SIZE blocks. Each block is row-major and contiguous, so walking the grid by rows, by
+// columns or by small neighbourhoods all stay within a few cache lines. The blocks themselves are laid out either row-major
+// or along a Morton (Z-order) curve.
+template<typename Value_T, size_t TILE_SIZE = 64, TileOrder TILE_ORDER = TileOrder::row_major>
+class TiledGrid
+{
+	static_assert(TILE_SIZE > 0 && (TILE_SIZE & (TILE_SIZE - 1)) == 0, "Tile size must be a power of two");
+
+public:
+	using Value_t = Value_T;
+	using Size_t = size_t;
+	using This_t = TiledGrid<Value_t, TILE_SIZE, TILE_ORDER>;
+
+	static constexpr Size_t tile_size = TILE_SIZE;
+	static constexpr Size_t tile_elements = TILE_SIZE * TILE_SIZE;
+	static constexpr TileOrder tile_order = TILE_ORDER;
+
+	Size_t n_rows;
+	Size_t n_cols;
+	Size_t n_elem;
+
+	TiledGrid()
+		: n_rows{ 0 }
+		, n_cols{ 0 }
+		, n_elem{ 0 }
+		, _tile_rows{ 0 }
+		, _tile_cols{ 0 }
+	{}
+
+	TiledGrid(Size_t rows, Size_t cols, Value_t fill_value = Value_t{})
+		: n_rows{ rows }
+		, n_cols{ cols }
+		, n_elem{ rows * cols }
+		, _tile_rows{ _tile_count(rows) }
+		, _tile_cols{ _tile_count(cols) }
+		, _values(_storage_tile_count(_tile_count(rows), _tile_count(cols)) * tile_elements, fill_value)
+	{}
+
+	TiledGrid(const TiledGrid&) = default;
+	TiledGrid& operator=(const TiledGrid&) = default;
+
+	TiledGrid(TiledGrid&&) = default;
+	TiledGrid& operator=(TiledGrid&&) = default;
+
+	template<typename Other_T>
+	static This_t from_matrix(const arma::Mat<Other_T>& mat)
+	{
+		auto out = This_t(mat.n_rows, mat.n_cols);
+		out.for_each_position(0, out.n_rows, 0, out.n_cols, [&out, &mat](auto r, auto c) {
+			out.at(r, c) = static_cast<Value_t>(mat.at(r, c));
+			});
+
+		return out;
+	}
+
+	arma::Mat<Value_t> as_matrix() const
+	{
+		auto out = arma::Mat<Value_t>(n_rows, n_cols);
+		for_each_position(0, n_rows, 0, n_cols, [this, &out](auto r, auto c) {
+			out.at(r, c) = at(r, c);
+			});
+
+		return out;
+	}
+
+	Value_t& at(Size_t row, Size_t col) { return _values[_index(row, col)]; }
+	const Value_t& at(Size_t row, Size_t col) const { return _values[_index(row, col)]; }
+
+	Value_t& operator()(Size_t row, Size_t col) { return at(row, col); }
+	const Value_t& operator()(Size_t row, Size_t col) const { return at(row, col); }
+
+	This_t& fill(const Value_t& value)
+	{
+		std::fill(_values.begin(), _values.end(), value);
+		return *this;
+	}
+
+	Size_t tile_rows() const { return _tile_rows; }
+	Size_t tile_cols() const { return _tile_cols; }
+
+	// The contiguous run of a row that lies in the given column of tiles.
+	std::span<Value_t> row_segment(Size_t row, Size_t tile_col)
+	{
+		return { &at(row, tile_col * TILE_SIZE), _segment_length(tile_col, n_cols) };
+	}
+
+	std::span<const Value_t> row_segment(Size_t row, Size_t tile_col) const
+	{
+		return { &at(row, tile_col * TILE_SIZE), _segment_length(tile_col, n_cols) };
+	}
+
+	template<typename Fn_T>
+	void for_each_in_row(Size_t row, Fn_T&& fn) const
+	{
+		for (Size_t tile_col = 0; tile_col < _tile_cols; ++tile_col) {
+			auto col = tile_col * TILE_SIZE;
+			for (const auto& value : row_segment(row, tile_col)) {
+				fn(col++, value);
+			}
+		}
+	}
+
+	template<typename Fn_T>
+	void for_each_in_col(Size_t col, Fn_T&& fn) const
+	{
+		for (Size_t tile_row = 0; tile_row < _tile_rows; ++tile_row) {
+			const auto row_begin = tile_row * TILE_SIZE;
+			const auto row_end = std::min(row_begin + TILE_SIZE, n_rows);
+
+			const auto* value = &at(row_begin, col);
+			for (auto row = row_begin; row < row_end; ++row, value += TILE_SIZE) {
+				fn(row, *value);
+			}
+		}
+	}
+
+	// Calls fn(row, col) for every position in [row_begin, row_end) x [col_begin, col_end), in storage order.
+	template<typename Fn_T>
+	void for_each_position(Size_t row_begin, Size_t row_end, Size_t col_begin, Size_t col_end, Fn_T&& fn) const
+	{
+		if (row_begin >= row_end || col_begin >= col_end) {
+			return;
+		}
+
+		const auto first_tile_row = row_begin / TILE_SIZE;
+		const auto last_tile_row = (row_end - 1) / TILE_SIZE;
+		const auto first_tile_col = col_begin / TILE_SIZE;
+		const auto last_tile_col = (col_end - 1) / TILE_SIZE;
+
+		auto visit_tile = [&](Size_t tile_row, Size_t tile_col) {
+			const auto r_0 = std::max(row_begin, tile_row * TILE_SIZE);
+			const auto r_1 = std::min(row_end, (tile_row + 1) * TILE_SIZE);
+			const auto c_0 = std::max(col_begin, tile_col * TILE_SIZE);
+			const auto c_1 = std::min(col_end, (tile_col + 1) * TILE_SIZE);
+
+			for (auto r = r_0; r < r_1; ++r) {
+				for (auto c = c_0; c < c_1; ++c) {
+					fn(r, c);
+				}
+			}
+		};
+
+		if constexpr (TileOrder::morton == TILE_ORDER) {
+			const auto storage_tiles = _storage_tile_count(_tile_rows, _tile_cols);
+			for (Size_t tile = 0; tile < storage_tiles; ++tile) {
+				const auto [tile_row, tile_col] = _morton_decode(tile);
+				if (tile_row < first_tile_row || tile_row > last_tile_row || tile_col < first_tile_col || tile_col > last_tile_col) {
+					continue;
+				}
+
+				visit_tile(tile_row, tile_col);
+			}
+		}
+		else {
+			for (auto tile_row = first_tile_row; tile_row <= last_tile_row; ++tile_row) {
+				for (auto tile_col = first_tile_col; tile_col <= last_tile_col; ++tile_col) {
+					visit_tile(tile_row, tile_col);
+				}
+			}
+		}
+	}
+
+private:
+
+	static constexpr Size_t _tile_count(Size_t cells)
+	{
+		return (cells + TILE_SIZE - 1) / TILE_SIZE;
+	}
+
+	static constexpr Size_t _segment_length(Size_t tile_idx, Size_t cells)
+	{
+		return std::min(TILE_SIZE, cells - tile_idx * TILE_SIZE);
+	}
+
+	static Size_t _storage_tile_count(Size_t tile_rows, Size_t tile_cols)
+	{
+		if constexpr (TileOrder::morton == TILE_ORDER) {
+			if (tile_rows == 0 || tile_cols == 0) {
+				return 0;
+			}
+
+			// Z-order indices cover the enclosing power-of-two square, so some storage tiles may go unused.
+			return _morton_encode(tile_rows - 1, tile_cols - 1) + 1;
+		}
+		else {
+			return tile_rows * tile_cols;
+		}
+	}
+
+	static constexpr uint64_t _spread_bits(uint64_t x)
+	{
+		x &= 0x00000000FFFFFFFFull;
+		x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+		x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+		x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		x = (x | (x << 2)) & 0x3333333333333333ull;
+		x = (x | (x << 1)) & 0x5555555555555555ull;
+
+		return x;
+	}
+
+	static constexpr uint64_t _compact_bits(uint64_t x)
+	{
+		x &= 0x5555555555555555ull;
+		x = (x | (x >> 1)) & 0x3333333333333333ull;
+		x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+		x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+		x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+		x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+
+		return x;
+	}
+
+	static constexpr Size_t _morton_encode(Size_t tile_row, Size_t tile_col)
+	{
+		return static_cast<Size_t>((_spread_bits(tile_row) << 1) | _spread_bits(tile_col));
+	}
+
+	static constexpr std::pair<Size_t, Size_t> _morton_decode(Size_t tile)
+	{
+		return { static_cast<Size_t>(_compact_bits(tile >> 1)), static_cast<Size_t>(_compact_bits(tile)) };
+	}
+
+	Size_t _tile_index(Size_t tile_row, Size_t tile_col) const
+	{
+		if constexpr (TileOrder::morton == TILE_ORDER) {
+			return _morton_encode(tile_row, tile_col);
+		}
+		else {
+			return tile_row * _tile_cols + tile_col;
+		}
+	}
+
+	Size_t _index(Size_t row, Size_t col) const
+	{
+		const auto tile = _tile_index(row / TILE_SIZE, col / TILE_SIZE);
+		return tile * tile_elements + (row % TILE_SIZE) * TILE_SIZE + (col % TILE_SIZE);
+	}
+
+	Size_t _tile_rows;
+	Size_t _tile_cols;
+	std::vector<Value_t> _values;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,73 @@
+"""Generates EmbeddedData.generated.hpp, which holds the puzzle inputs in Data/ as constexpr string_views.
+
+Run automatically as a pre-build step when the project is built with /p:AocEmbedInputs=true. The data is written as
+character arrays rather than string literals so that it isn't subject to MSVC's string literal length limits.
+
+usage: embed_inputs.py <data dir> <output header> [file names...]
+"""
+
+import pathlib
+import re
+import sys
+
+HEADER = """#pragma once
+
+// Generated by embed_inputs.py - do not edit.
+
+namespace aoc
+{
+namespace embedded
+{
+namespace data
+{
+"""
+
+FOOTER = """
+}	// namespace: data
+}	// namespace: embedded
+}	// namespace: aoc
+"""
+
+BYTES_PER_LINE = 32
+
+
+def identifier_for(path):
+    return re.sub(r"\W", "_", path.stem).lower()
+
+
+def embed(path):
+    name = identifier_for(path)
+    content = path.read_bytes().replace(b"\r\n", b"\n")
+
+    lines = [f"\ninline constexpr char _{name}[] = {{"]
+    for start in range(0, len(content), BYTES_PER_LINE):
+        chunk = content[start:start + BYTES_PER_LINE]
+        lines.append("\t" + ", ".join(str(b) for b in chunk) + ",")
+    lines.append("\t0")
+    lines.append("};")
+    lines.append(f"inline constexpr std::string_view {name}{{ _{name}, sizeof(_{name}) - 1 }};")
+
+    return "\n".join(lines) + "\n"
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__, file=sys.stderr)
+        return 1
+
+    data_dir = pathlib.Path(argv[1])
+    output = pathlib.Path(argv[2])
+    files = [data_dir / name for name in argv[3:]] if len(argv) > 3 else sorted(data_dir.glob("*.txt"))
+
+    text = HEADER + "".join(embed(f) for f in files) + FOOTER
+
+    if output.exists() and output.read_text() == text:
+        return 0
+
+    output.write_text(text)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
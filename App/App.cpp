@@ -6,6 +6,7 @@
 #include "../AdventOfCode/AdventOfCode.hpp"
 #include "../AdventOfCode/Lanternfish.hpp"
 #include "../AdventOfCode/CrabSorter.hpp"
+#include "../AdventOfCode/Pipeline.hpp"
 
 #include <vector>
 #include <cstdint>
@@ -26,21 +27,46 @@ int main()
 {
 	using namespace aoc;
 
-	auto sub = Submarine{};
+	using VentPipeline_t = Pipeline<std::filesystem::path, std::string, std::shared_ptr<std::istream>, uint32_t>;
 
-	std::cout << "Running..." << std::endl;
+	auto pipeline = VentPipeline_t(
+		[](const std::filesystem::path& path) {
+			std::ifstream data_file(path);
+			if (!data_file) {
+				throw IOException(std::format("Failed to open {}", path.string()));
+			}
 
-	for (int i = 0; i < 500; ++i)
-	{
-		std::ifstream data_file(DATA_DIR / "Day5_input.txt");
-		if (!data_file)
-		{
-			std::cerr << "Failed to open file" << std::endl;
-			return 1;
+			return std::string(std::istreambuf_iterator<char>{ data_file }, std::istreambuf_iterator<char>{});
+		},
+		[](std::string data) -> std::shared_ptr<std::istream> {
+			return std::make_shared<std::stringstream>(std::move(data));
+		},
+		[](std::shared_ptr<std::istream> data) {
+			return Submarine()
+				.boat_systems()
+				.detect_vents<VentAnalyzer::horizontal | VentAnalyzer::vertical | VentAnalyzer::diagonal>(*data);
 		}
-		const auto vent_score = aoc::Submarine()
-			.boat_systems()
-			.detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>(data_file);
+	);
+
+	const auto workers = std::max(std::thread::hardware_concurrency(), 2u);
+	pipeline.workers(VentPipeline_t::Stage::solve, workers - 1).queue_capacity(2 * workers);
+
+	std::cout << "Running..." << std::endl;
+
+	try {
+		pipeline.run(std::vector<std::filesystem::path>(500, DATA_DIR / "Day5_input.txt"));
+	}
+	catch (const Exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	for (const auto& [name, stage] : { std::pair{ "read", VentPipeline_t::Stage::read }, std::pair{ "parse", VentPipeline_t::Stage::parse }, std::pair{ "solve", VentPipeline_t::Stage::solve } }) {
+		const auto& stats = pipeline.stats(stage);
+		std::cout << std::format("{:>5}: {} items, mean {}us, min {}us, max {}us", name, stats.count,
+			std::chrono::duration_cast<std::chrono::microseconds>(stats.mean()).count(),
+			std::chrono::duration_cast<std::chrono::microseconds>(stats.min).count(),
+			std::chrono::duration_cast<std::chrono::microseconds>(stats.max).count()) << std::endl;
 	}
 
 	std::cout << "Done" << std::endl;